@@ -0,0 +1,246 @@
+#ifndef JC_BENCH_CPU_TOPOLOGY_H
+#define JC_BENCH_CPU_TOPOLOGY_H
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace jc::bench
+{
+
+/*
+ * Where a CPU sits, as read from sysfs. Caches and cores are identified by the lowest CPU sharing them, which is
+ * unique and doesn't depend on the kernel exposing cache ids.
+ */
+struct cpu_info
+{
+    int cpu_     = 0;
+    int core_    = 0;
+    int package_ = 0;
+    int l3_      = 0;
+    int node_    = 0;
+};
+
+/*
+ * How far apart a producer and consumer are, from sharing a physical core to sitting on different NUMA nodes.
+ */
+enum class pairing
+{
+    smt,
+    same_l3,
+    cross_l3,
+    cross_numa,
+};
+
+inline constexpr std::array<pairing, 4> all_pairings = {pairing::smt, pairing::same_l3, pairing::cross_l3,
+                                                         pairing::cross_numa};
+
+inline constexpr std::string_view pairing_name(const pairing kind) noexcept
+{
+    switch (kind)
+    {
+    case pairing::smt:
+        return "smt";
+    case pairing::same_l3:
+        return "same_l3";
+    case pairing::cross_l3:
+        return "cross_l3";
+    case pairing::cross_numa:
+        return "cross_numa";
+    }
+    return "unknown";
+}
+
+/*
+ * parses the kernel's cpu list format, e.g. "0-3,8,10-11".
+ */
+inline std::vector<int> parse_cpu_list(std::string_view list)
+{
+    std::vector<int> cpus;
+    while (!list.empty())
+    {
+        const std::size_t comma     = list.find(',');
+        const std::string_view part = list.substr(0, comma);
+        list                        = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+        int first = 0;
+        int last  = 0;
+
+        const auto [end, error] = std::from_chars(part.data(), part.data() + part.size(), first);
+        if (error != std::errc{})
+        {
+            continue;
+        }
+        last = first;
+        if (end != part.data() + part.size() && *end == '-')
+        {
+            std::from_chars(end + 1, part.data() + part.size(), last);
+        }
+        for (int cpu = first; cpu <= last; cpu++)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+class cpu_topology
+{
+public:
+    /**
+     * @brief Reads every online CPU under `root`. An unreadable tree leaves the topology empty.
+     */
+    explicit cpu_topology(const std::filesystem::path &root = "/sys/devices/system/cpu")
+    {
+        for (const int cpu : parse_cpu_list(read_line(root / "online")))
+        {
+            const std::filesystem::path dir = root / ("cpu" + std::to_string(cpu));
+            cpu_info info;
+            info.cpu_     = cpu;
+            info.core_    = lowest(read_line(dir / "topology" / "thread_siblings_list"), cpu);
+            info.package_ = read_int(dir / "topology" / "physical_package_id", 0);
+            info.l3_      = info.core_;
+            info.node_    = 0;
+
+            std::error_code error;
+            for (const auto &entry : std::filesystem::directory_iterator(dir / "cache", error))
+            {
+                if (read_int(entry.path() / "level", 0) == 3)
+                {
+                    info.l3_ = lowest(read_line(entry.path() / "shared_cpu_list"), cpu);
+                }
+            }
+            for (const auto &entry : std::filesystem::directory_iterator(dir, error))
+            {
+                const std::string name = entry.path().filename().string();
+                if (name.starts_with("node"))
+                {
+                    std::from_chars(name.data() + 4, name.data() + name.size(), info.node_);
+                }
+            }
+            cpus_.push_back(info);
+        }
+    }
+
+    [[nodiscard]] const std::vector<cpu_info> &cpus() const noexcept
+    {
+        return cpus_;
+    }
+
+    /**
+     * @brief Two CPUs `kind` apart, keeping off CPU 0 where possible since it usually takes the interrupts.
+     */
+    [[nodiscard]] std::optional<std::pair<int, int>> find_pair(const pairing kind) const
+    {
+        for (const bool allow_cpu0 : {false, true})
+        {
+            for (const cpu_info &a : cpus_)
+            {
+                for (const cpu_info &b : cpus_)
+                {
+                    if (a.cpu_ == b.cpu_ || (!allow_cpu0 && (a.cpu_ == 0 || b.cpu_ == 0)))
+                    {
+                        continue;
+                    }
+                    if (matches(kind, a, b))
+                    {
+                        return std::pair{a.cpu_, b.cpu_};
+                    }
+                }
+            }
+        }
+        return {};
+    }
+
+    /**
+     * @brief The closest pairing that doesn't share a core, what a producer and consumer usually get deployed on.
+     */
+    [[nodiscard]] std::pair<int, int> default_pair() const
+    {
+        for (const pairing kind : {pairing::same_l3, pairing::cross_l3, pairing::cross_numa, pairing::smt})
+        {
+            if (auto pair = find_pair(kind))
+            {
+                return *pair;
+            }
+        }
+        return {0, 0};
+    }
+
+    /**
+     * @brief One line per CPU, for the benchmark context.
+     */
+    [[nodiscard]] std::string describe() const
+    {
+        std::string text;
+        for (const cpu_info &info : cpus_)
+        {
+            text += "cpu" + std::to_string(info.cpu_) + ":core" + std::to_string(info.core_) + ",l3_" +
+                    std::to_string(info.l3_) + ",node" + std::to_string(info.node_) + ";";
+        }
+        return text;
+    }
+
+private:
+    static bool matches(const pairing kind, const cpu_info &a, const cpu_info &b) noexcept
+    {
+        const bool same_core = a.core_ == b.core_ && a.package_ == b.package_;
+        switch (kind)
+        {
+        case pairing::smt:
+            return same_core;
+        case pairing::same_l3:
+            return !same_core && a.l3_ == b.l3_;
+        case pairing::cross_l3:
+            return a.l3_ != b.l3_ && a.node_ == b.node_;
+        case pairing::cross_numa:
+            return a.node_ != b.node_;
+        }
+        return false;
+    }
+
+    static std::string read_line(const std::filesystem::path &path)
+    {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+
+    static int read_int(const std::filesystem::path &path, const int fallback)
+    {
+        const std::string line = read_line(path);
+        int value              = fallback;
+        std::from_chars(line.data(), line.data() + line.size(), value);
+        return value;
+    }
+
+    static int lowest(const std::string &list, const int fallback)
+    {
+        const std::vector<int> cpus = parse_cpu_list(list);
+        return cpus.empty() ? fallback : *std::min_element(cpus.begin(), cpus.end());
+    }
+
+    std::vector<cpu_info> cpus_;
+};
+
+/*
+ * the CPU for thread `thread_index` of a two thread producer/consumer benchmark, from this machine's default_pair().
+ */
+inline int pair_cpu(const int thread_index)
+{
+    static const std::pair<int, int> cpus = cpu_topology().default_pair();
+    return thread_index == 0 ? cpus.first : cpus.second;
+}
+
+} // namespace jc::bench
+
+#endif
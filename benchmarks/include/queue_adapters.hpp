@@ -0,0 +1,175 @@
+#ifndef JC_BENCH_QUEUE_ADAPTERS_H
+#define JC_BENCH_QUEUE_ADAPTERS_H
+
+#include <jc_collections/lockfree/spsc.hpp>
+#include <jc_collections/lockfree/unbounded_spsc.hpp>
+#include <jc_collections/util.h>
+#include "SPSCQueue.h" // rigtorps queue
+#include <boost/lockfree/spsc_queue.hpp> // boost
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+namespace jc::bench
+{
+
+/*
+ * a message of `bytes` bytes, the first word doubles as a sequence number.
+ */
+template <std::size_t bytes>
+    requires(bytes >= sizeof(u64)) && (bytes % sizeof(u64) == 0)
+struct payload
+{
+    u64 words_[bytes / sizeof(u64)];
+};
+
+/*
+ * one blocking push/pop interface over every queue we compare, so a benchmark is written once and instantiated per
+ * queue, element type and capacity.
+ */
+template <typename T, std::size_t capacity>
+struct jc_simple
+{
+    static constexpr std::string_view name = "simple_spsc";
+    jc::lockfree::simple_spsc<T, capacity> queue_;
+
+    void push(T &value) noexcept
+    {
+        queue_.put(value);
+    }
+
+    T pop() noexcept
+    {
+        return queue_.read();
+    }
+};
+
+template <typename T, std::size_t capacity>
+struct jc_cached
+{
+    static constexpr std::string_view name = "cached_spsc";
+    jc::lockfree::cached_spsc<T, capacity> queue_;
+
+    void push(T &value) noexcept
+    {
+        queue_.put(value);
+    }
+
+    T pop() noexcept
+    {
+        return queue_.read();
+    }
+};
+
+/*
+ * cached_spsc with the prefetch and read index release policies swapped in.
+ */
+template <typename T, std::size_t capacity, typename prefetch, typename release>
+struct jc_cached_tuned
+{
+    static constexpr bool prefetches    = prefetch::lines > 0;
+    static constexpr bool line_releases = std::is_same_v<release, jc::lockfree::spsc_policy::release_per_line>;
+    static constexpr std::string_view name =
+        prefetches && line_releases ? "cached_spsc_prefetch_line_release"
+        : prefetches                ? "cached_spsc_prefetch"
+        : line_releases             ? "cached_spsc_line_release"
+                                    : "cached_spsc";
+
+    jc::lockfree::basic_spsc<T, capacity, jc::lockfree::spsc_policy::cached_indexes,
+                             jc::lockfree::spsc_policy::padding::cache_line, jc::lockfree::spsc_policy::spin_wait,
+                             jc::lockfree::spsc_policy::move_transfer, jc::lockfree::spsc_policy::bounded, prefetch,
+                             release>
+        queue_;
+
+    void push(T &value) noexcept
+    {
+        queue_.put(value);
+    }
+
+    T pop() noexcept
+    {
+        return queue_.read();
+    }
+};
+
+template <typename T, std::size_t capacity>
+using jc_cached_prefetch =
+    jc_cached_tuned<T, capacity, jc::lockfree::spsc_policy::prefetch_ahead<2>, jc::lockfree::spsc_policy::release_each>;
+
+template <typename T, std::size_t capacity>
+using jc_cached_line_release = jc_cached_tuned<T, capacity, jc::lockfree::spsc_policy::no_prefetch,
+                                               jc::lockfree::spsc_policy::release_per_line>;
+
+template <typename T, std::size_t capacity>
+using jc_cached_prefetch_line_release = jc_cached_tuned<T, capacity, jc::lockfree::spsc_policy::prefetch_ahead<2>,
+                                                        jc::lockfree::spsc_policy::release_per_line>;
+
+template <typename T, std::size_t capacity>
+struct jc_unbounded
+{
+    static constexpr std::string_view name = "unbounded_spsc";
+    jc::lockfree::unbounded_spsc<T, capacity> queue_;
+
+    void push(T &value) noexcept
+    {
+        // only fails if a new segment can't be allocated
+        while (!queue_.put(value))
+        {
+        }
+    }
+
+    T pop() noexcept
+    {
+        return queue_.read();
+    }
+};
+
+template <typename T, std::size_t capacity>
+struct rigtorp_queue
+{
+    static constexpr std::string_view name = "rigtorp";
+    rigtorp::SPSCQueue<T> queue_{capacity};
+
+    void push(T &value) noexcept
+    {
+        queue_.push(value);
+    }
+
+    T pop() noexcept
+    {
+        while (!queue_.front())
+        {
+        }
+        T value = *queue_.front();
+        queue_.pop();
+        return value;
+    }
+};
+
+template <typename T, std::size_t capacity>
+struct boost_queue
+{
+    static constexpr std::string_view name = "boost";
+    boost::lockfree::spsc_queue<T, boost::lockfree::capacity<capacity>> queue_;
+
+    void push(T &value) noexcept
+    {
+        while (!queue_.push(value))
+        {
+        }
+    }
+
+    T pop() noexcept
+    {
+        T value;
+        while (!queue_.pop(value))
+        {
+        }
+        return value;
+    }
+};
+
+} // namespace jc::bench
+
+#endif
@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/memory/abstract_allocator.hpp>
+#include <jc_collections/memory/cached_pool_allocator.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace
+{
+
+struct node
+{
+    u64 key_;
+    u64 value_;
+};
+
+// a small working set of live blocks so every upstream reaches a steady state
+constexpr std::size_t live_blocks = 64;
+
+/*
+ * the same churn loop for every variant, `alloc`/`dealloc` are either the adapter or the upstream called by hand.
+ */
+template <typename Allocate, typename Deallocate>
+void churn(benchmark::State &state, Allocate alloc, Deallocate dealloc)
+{
+    std::array<node *, live_blocks> blocks{};
+    for (node *&block : blocks)
+    {
+        block = alloc();
+    }
+
+    std::size_t next = 0;
+    for (auto _ : state)
+    {
+        dealloc(blocks[next]);
+        blocks[next] = alloc();
+        // the whole array goes through the "+m" overload, gcc mishandles "+m,r" on a single pointer here
+        benchmark::DoNotOptimize(blocks);
+        next = (next + 1) % live_blocks;
+    }
+
+    for (node *block : blocks)
+    {
+        dealloc(block);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+static void bm_pmr_direct(benchmark::State &state)
+{
+    std::pmr::unsynchronized_pool_resource pool;
+    churn(
+        state, [&] { return static_cast<node *>(pool.allocate(sizeof(node), alignof(node))); },
+        [&](node *p) { pool.deallocate(p, sizeof(node), alignof(node)); });
+}
+
+static void bm_pmr_adapter(benchmark::State &state)
+{
+    std::pmr::unsynchronized_pool_resource pool;
+    jc::memory::abstract_allocator<std::pmr::unsynchronized_pool_resource, node> adapter(pool);
+    churn(state, [&] { return adapter.allocate(1); }, [&](node *p) { adapter.deallocate(p, 1); });
+}
+
+/*
+ * through the base class, so every call is virtual in both variants.
+ */
+static void bm_pmr_base_adapter(benchmark::State &state)
+{
+    std::pmr::unsynchronized_pool_resource pool;
+    jc::memory::abstract_allocator<std::pmr::memory_resource, node> adapter(pool);
+    churn(state, [&] { return adapter.allocate(1); }, [&](node *p) { adapter.deallocate(p, 1); });
+}
+
+static void bm_std_direct(benchmark::State &state)
+{
+    std::allocator<node> upstream;
+    churn(state, [&] { return upstream.allocate(1); }, [&](node *p) { upstream.deallocate(p, 1); });
+}
+
+static void bm_std_adapter(benchmark::State &state)
+{
+    jc::memory::abstract_allocator<std::allocator<node>, node> adapter;
+    static_assert(sizeof(adapter) == 1, "a stateless allocator must not take space");
+    churn(state, [&] { return adapter.allocate(1); }, [&](node *p) { adapter.deallocate(p, 1); });
+}
+
+static void bm_pool_direct(benchmark::State &state)
+{
+    std::pmr::memory_resource *heap = std::pmr::new_delete_resource();
+    auto upstream = std::make_unique<jc::memory::cached_pool_allocator<node, 4096, std::pmr::memory_resource>>(*heap);
+    churn(state, [&] { return upstream->allocate(1); }, [&](node *p) { upstream->deallocate(p, 1); });
+}
+
+static void bm_pool_adapter(benchmark::State &state)
+{
+    using pool_type                 = jc::memory::cached_pool_allocator<node, 4096, std::pmr::memory_resource>;
+    std::pmr::memory_resource *heap = std::pmr::new_delete_resource();
+    auto upstream                   = std::make_unique<pool_type>(*heap);
+    jc::memory::abstract_allocator<pool_type, node> adapter(*upstream);
+    churn(state, [&] { return adapter.allocate(1); }, [&](node *p) { adapter.deallocate(p, 1); });
+}
+
+/*
+ * a cache line aligned block out of a plain allocator, the adapter rebinds to an over-aligned type.
+ */
+static void bm_std_aligned_adapter(benchmark::State &state)
+{
+    jc::memory::abstract_allocator<std::allocator<node>, node> adapter;
+    churn(
+        state, [&] { return adapter.allocate_aligned<64>(1); }, [&](node *p) { adapter.deallocate_aligned<64>(p, 1); });
+}
+
+static void bm_pmr_bulk_adapter(benchmark::State &state)
+{
+    std::pmr::unsynchronized_pool_resource pool;
+    jc::memory::abstract_allocator<std::pmr::unsynchronized_pool_resource, node> adapter(pool);
+    std::array<node *, live_blocks> blocks{};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(adapter.allocate_bulk(blocks, 1));
+        adapter.deallocate_bulk(blocks, 1);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<i64>(live_blocks));
+}
+
+BENCHMARK(bm_pmr_direct);
+BENCHMARK(bm_pmr_adapter);
+BENCHMARK(bm_pmr_base_adapter);
+BENCHMARK(bm_std_direct);
+BENCHMARK(bm_std_adapter);
+BENCHMARK(bm_pool_direct);
+BENCHMARK(bm_pool_adapter);
+BENCHMARK(bm_std_aligned_adapter);
+BENCHMARK(bm_pmr_bulk_adapter);
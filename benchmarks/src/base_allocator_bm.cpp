@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/memory/base_allocator.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+
+using jc::memory::base_allocator;
+using jc::memory::commit_mode;
+using jc::memory::release_mode;
+
+namespace
+{
+
+constexpr std::size_t arena_bytes = 512 << 20;
+constexpr std::size_t block_bytes = 4096;
+
+double rss_mb()
+{
+    std::ifstream statm("/proc/self/statm");
+    std::size_t pages    = 0;
+    std::size_t resident = 0;
+    statm >> pages >> resident;
+    return static_cast<double>(resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE))) / (1 << 20);
+}
+
+/*
+ * fills `burst` bytes of the arena the way a real burst would, writing every block so the pages become resident.
+ */
+void burst(base_allocator &arena, const std::size_t bytes)
+{
+    for (std::size_t filled = 0; filled < bytes; filled += block_bytes)
+    {
+        void *block = arena.allocate(block_bytes, 64);
+        std::memset(block, 1, block_bytes);
+        benchmark::DoNotOptimize(block);
+    }
+}
+
+enum class cycle_end
+{
+    reset,
+    trim_dont_need,
+    trim_free,
+};
+
+/*
+ * one burst then whatever the arena does between bursts. Arguments: burst size in MB, commit mode, how the cycle ends.
+ */
+void bm_cycle(benchmark::State &state)
+{
+    const auto bytes = static_cast<std::size_t>(state.range(0)) << 20;
+    const auto mode  = static_cast<commit_mode>(state.range(1));
+    const auto end   = static_cast<cycle_end>(state.range(2));
+    base_allocator arena(arena_bytes, mode);
+    double peak = 0;
+    for (auto _ : state)
+    {
+        burst(arena, bytes);
+        state.PauseTiming();
+        peak = rss_mb();
+        state.ResumeTiming();
+        switch (end)
+        {
+        case cycle_end::reset:
+            arena.reset();
+            break;
+        case cycle_end::trim_dont_need:
+            arena.reset_and_trim(0, release_mode::dont_need);
+            break;
+        case cycle_end::trim_free:
+            arena.reset_and_trim(0, release_mode::free);
+            break;
+        }
+    }
+    state.counters["peak_rss_mb"]  = peak;
+    state.counters["after_rss_mb"] = rss_mb();
+    state.SetBytesProcessed(state.iterations() * static_cast<i64>(bytes));
+}
+
+/*
+ * RSS over time for a long running owner: a large burst every tenth cycle, small ones otherwise, trimming back to a
+ * resident floor after each. The counters record RSS after the last large burst and at the end.
+ */
+void bm_rss_over_time(benchmark::State &state)
+{
+    const auto mode = static_cast<commit_mode>(state.range(0));
+    const bool trim = state.range(1) != 0;
+    constexpr std::size_t keep = 8 << 20;
+    base_allocator arena(arena_bytes, mode);
+    double after_large = 0;
+    std::size_t cycle  = 0;
+    for (auto _ : state)
+    {
+        const bool large = cycle++ % 10 == 0;
+        burst(arena, large ? 256 << 20 : 4 << 20);
+        if (trim)
+        {
+            arena.reset_and_trim(keep);
+        }
+        else
+        {
+            arena.reset();
+        }
+        if (large)
+        {
+            state.PauseTiming();
+            after_large = rss_mb();
+            state.ResumeTiming();
+        }
+    }
+    state.counters["rss_after_large_mb"] = after_large;
+    state.counters["rss_end_mb"]         = rss_mb();
+}
+
+} // namespace
+
+BENCHMARK(bm_cycle)
+    ->ArgNames({"mb", "lazy", "end"})
+    ->ArgsProduct({{1, 64}, {0, 1}, {0, 1, 2}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(bm_rss_over_time)
+    ->ArgNames({"lazy", "trim"})
+    ->ArgsProduct({{0, 1}, {0, 1}})
+    ->Iterations(20)
+    ->Unit(benchmark::kMillisecond);
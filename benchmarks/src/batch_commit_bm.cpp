@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/lockfree/spsc.hpp>
+#include <jc_collections/lockfree/thread_pool.hpp>
+#include "../include/cpu_topology.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+/*
+ * Batched index publishing against today's per element store, at batch sizes 4, 16 and 64: the consumer batching
+ * its read index alone, and both sides batching. Throughput is the usual two thread put/read loop. Latency has the
+ * producer send bursts and flush at the end of each one, like a feed handler draining a socket read, and the
+ * consumer reports the publish-to-read percentiles.
+ */
+namespace
+{
+
+namespace policy = jc::lockfree::spsc_policy;
+
+constexpr std::size_t ring_size = 4096;
+constexpr std::size_t burst     = 32;
+
+struct stamped
+{
+    u64 sequence_;
+    i64 sent_ns_;
+};
+
+template <typename release, typename publishing>
+using batched_ring = jc::lockfree::basic_spsc<stamped, ring_size, policy::cached_indexes, policy::padding::cache_line,
+                                              policy::spin_wait, policy::move_transfer, policy::bounded,
+                                              policy::no_prefetch, release, publishing>;
+
+i64 now_ns() noexcept
+{
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+template <typename Queue>
+void bm_batch_throughput(benchmark::State &state)
+{
+    static Queue queue;
+    jc::lockfree::pin_current_thread(jc::bench::pair_cpu(state.thread_index()));
+    if (state.thread_index() == 0)
+    {
+        const auto last = static_cast<u64>(state.max_iterations);
+        u64 i           = 0;
+        for (auto _ : state)
+        {
+            queue.put(stamped{i++, 0});
+            // both loops end on a barrier, the consumer can't be left waiting on a held back batch
+            if (i == last)
+            {
+                queue.flush_writes();
+            }
+        }
+    }
+    else
+    {
+        for (auto _ : state)
+        {
+            stamped value = queue.read();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Queue>
+void bm_batch_latency(benchmark::State &state)
+{
+    static Queue queue;
+    jc::lockfree::pin_current_thread(jc::bench::pair_cpu(state.thread_index()));
+    if (state.thread_index() == 0)
+    {
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < burst; i++)
+            {
+                queue.put(stamped{i, now_ns()});
+            }
+            queue.flush_writes();
+        }
+        return;
+    }
+
+    std::vector<i64> latencies;
+    latencies.reserve(static_cast<std::size_t>(state.max_iterations) * burst);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < burst; i++)
+        {
+            const stamped value = queue.read();
+            latencies.push_back(now_ns() - value.sent_ns_);
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&](const double p) {
+        return static_cast<double>(latencies[static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1))]);
+    };
+    state.counters["p50_ns"]  = percentile(0.50);
+    state.counters["p99_ns"]  = percentile(0.99);
+    state.counters["p999_ns"] = percentile(0.999);
+    state.counters["max_ns"]  = static_cast<double>(latencies.back());
+    state.SetItemsProcessed(state.iterations() * static_cast<i64>(burst));
+}
+
+} // namespace
+
+#define JC_BATCH_BENCHMARKS(...)                                                                                       \
+    BENCHMARK_TEMPLATE(bm_batch_throughput, batched_ring<__VA_ARGS__>)->Threads(2)->UseRealTime();                     \
+    BENCHMARK_TEMPLATE(bm_batch_latency, batched_ring<__VA_ARGS__>)->Threads(2)->UseRealTime()
+
+JC_BATCH_BENCHMARKS(policy::release_each, policy::publish_each);
+JC_BATCH_BENCHMARKS(policy::release_every<4>, policy::publish_each);
+JC_BATCH_BENCHMARKS(policy::release_every<16>, policy::publish_each);
+JC_BATCH_BENCHMARKS(policy::release_every<64>, policy::publish_each);
+JC_BATCH_BENCHMARKS(policy::release_every<4>, policy::publish_every<4>);
+JC_BATCH_BENCHMARKS(policy::release_every<16>, policy::publish_every<16>);
+JC_BATCH_BENCHMARKS(policy::release_every<64>, policy::publish_every<64>);
@@ -0,0 +1,238 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/collections/flat_map.hpp>
+#include <jc_collections/memory/base_allocator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+#include <version>
+
+#if defined(__cpp_lib_flat_map)
+#include <flat_map>
+#endif
+
+/*
+ * Find cost of a u64 -> u32 map with 1K to 10M random keys: std::map, std::flat_map when the standard library has
+ * it, and flat_map with each of its search layouts.
+ *
+ * Throughput runs independent finds, so the out of order core overlaps their misses. Latency makes each query depend
+ * on the value the previous find returned, so the finds run one after another and the time is a full walk from the
+ * root, which is what a single lookup on the hot path pays. The queries are existing keys in random order.
+ */
+namespace
+{
+
+constexpr std::size_t query_count = 1 << 20;
+
+struct dataset
+{
+    std::vector<u64> keys;
+    std::vector<u32> values;
+    std::vector<u64> queries;
+};
+
+u64 splitmix(u64 &state) noexcept
+{
+    u64 z = state += 0x9E3779B97F4A7C15;
+    z     = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z     = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+// the 10M key set alone is 120MB, only the last one asked for is kept
+const dataset &data(const std::size_t n)
+{
+    static std::size_t built = 0;
+    static dataset set;
+    if (built != n)
+    {
+        u64 state = n;
+        set.keys.resize(n);
+        std::generate(set.keys.begin(), set.keys.end(), [&] { return splitmix(state); });
+        std::sort(set.keys.begin(), set.keys.end());
+        set.keys.erase(std::unique(set.keys.begin(), set.keys.end()), set.keys.end());
+        set.values.resize(set.keys.size());
+        for (std::size_t i = 0; i < set.values.size(); i++)
+        {
+            set.values[i] = static_cast<u32>(i);
+        }
+        set.queries.resize(query_count);
+        std::generate(set.queries.begin(), set.queries.end(),
+                      [&] { return set.keys[splitmix(state) % set.keys.size()]; });
+        built = n;
+    }
+    return set;
+}
+
+struct std_map
+{
+    explicit std_map(const dataset &set)
+    {
+        for (std::size_t i = 0; i < set.keys.size(); i++)
+        {
+            map_.emplace_hint(map_.end(), set.keys[i], set.values[i]);
+        }
+    }
+
+    const u32 *find(const u64 key) const noexcept
+    {
+        const auto it = map_.find(key);
+        return it == map_.end() ? nullptr : &it->second;
+    }
+
+    std::map<u64, u32> map_;
+};
+
+#if defined(__cpp_lib_flat_map)
+struct std_flat_map
+{
+    explicit std_flat_map(const dataset &set) : map_(std::sorted_unique, set.keys, set.values)
+    {
+    }
+
+    const u32 *find(const u64 key) const noexcept
+    {
+        const auto it = map_.find(key);
+        return it == map_.end() ? nullptr : &it->second;
+    }
+
+    std::flat_map<u64, u32> map_;
+};
+#endif
+
+template <typename Layout>
+struct jc_flat_map
+{
+    // room for the keys, the values and a layout's copy of the keys with their positions, committed as it is used
+    explicit jc_flat_map(const dataset &set)
+        : arena_(set.keys.size() * 64 + (1 << 20), jc::memory::commit_mode::lazy), map_(arena_)
+    {
+        built_ = arena_.successful_init() && map_.assign_sorted(set.keys, set.values);
+    }
+
+    bool built() const noexcept
+    {
+        return built_;
+    }
+
+    const u32 *find(const u64 key) const noexcept
+    {
+        return map_.find(key);
+    }
+
+    jc::memory::base_allocator arena_;
+    jc::collections::flat_map<u64, u32, Layout> map_;
+    bool built_ = false;
+};
+
+using flat_sorted    = jc_flat_map<jc::collections::flat_layout::sorted>;
+using flat_eytzinger = jc_flat_map<jc::collections::flat_layout::eytzinger>;
+using flat_btree     = jc_flat_map<jc::collections::flat_layout::btree>;
+
+/*
+ * the map being measured. There is a single slot for every map type, so building one destroys whichever was there
+ * before: a 10M entry std::map is over half a gigabyte on its own.
+ */
+struct fixture_slot
+{
+    const void *type = nullptr;
+    std::size_t n    = 0;
+    std::shared_ptr<const void> map;
+};
+
+fixture_slot current_fixture;
+
+template <typename Map>
+bool built(const Map &map) noexcept
+{
+    if constexpr (requires { map.built(); })
+    {
+        return map.built();
+    }
+    else
+    {
+        return true;
+    }
+}
+
+/*
+ * nullptr if the map couldn't be built.
+ */
+template <typename Map>
+const Map *fixture(const std::size_t n)
+{
+    // one per map type, its address tells the types apart
+    static const char type_tag = 0;
+    if (current_fixture.type != &type_tag || current_fixture.n != n)
+    {
+        current_fixture = {};
+        current_fixture = {&type_tag, n, std::make_shared<const Map>(data(n))};
+    }
+    const auto *map = static_cast<const Map *>(current_fixture.map.get());
+    return built(*map) ? map : nullptr;
+}
+
+template <typename Map>
+void bm_find_throughput(benchmark::State &state)
+{
+    const auto n       = static_cast<std::size_t>(state.range(0));
+    const Map *map     = fixture<Map>(n);
+    const dataset &set = data(n);
+    if (map == nullptr)
+    {
+        state.SkipWithError("could not build the map");
+        return;
+    }
+    std::size_t i       = 0;
+    std::size_t missing = 0;
+    for (auto _ : state)
+    {
+        const u32 *value = map->find(set.queries[i++ & (query_count - 1)]);
+        missing += value == nullptr ? 1 : 0;
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["missing"] = static_cast<double>(missing);
+}
+
+template <typename Map>
+void bm_find_latency(benchmark::State &state)
+{
+    const auto n       = static_cast<std::size_t>(state.range(0));
+    const Map *map     = fixture<Map>(n);
+    const dataset &set = data(n);
+    if (map == nullptr)
+    {
+        state.SkipWithError("could not build the map");
+        return;
+    }
+    std::size_t i       = 0;
+    u32 last            = 0;
+    std::size_t missing = 0;
+    for (auto _ : state)
+    {
+        // the next query can't be picked before the previous find returned
+        const u32 *value = map->find(set.queries[(i++ + (last & 1)) & (query_count - 1)]);
+        missing += value == nullptr ? 1 : 0;
+        last = value == nullptr ? 0 : *value;
+    }
+    benchmark::DoNotOptimize(last);
+    state.SetItemsProcessed(state.iterations());
+    state.counters["missing"] = static_cast<double>(missing);
+}
+
+} // namespace
+
+#define JC_FLAT_MAP_BENCHMARKS(map)                                                                                    \
+    BENCHMARK_TEMPLATE(bm_find_throughput, map)->RangeMultiplier(10)->Range(1'000, 10'000'000);                        \
+    BENCHMARK_TEMPLATE(bm_find_latency, map)->RangeMultiplier(10)->Range(1'000, 10'000'000)
+
+JC_FLAT_MAP_BENCHMARKS(std_map);
+#if defined(__cpp_lib_flat_map)
+JC_FLAT_MAP_BENCHMARKS(std_flat_map);
+#endif
+JC_FLAT_MAP_BENCHMARKS(flat_sorted);
+JC_FLAT_MAP_BENCHMARKS(flat_eytzinger);
+JC_FLAT_MAP_BENCHMARKS(flat_btree);
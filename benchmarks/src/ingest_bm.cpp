@@ -0,0 +1,195 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/io/ingest.hpp>
+#include <jc_collections/lockfree/spsc.hpp>
+#include <jc_collections/memory/base_allocator.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <thread>
+
+namespace
+{
+
+constexpr std::size_t message_size = 1024;
+// messages consumed per benchmark iteration
+constexpr std::int64_t batch = 4096;
+
+using ingest_type  = jc::io::ingest<1024, message_size>;
+using message_type = std::array<std::byte, message_size>;
+
+/*
+ * a receiving socket on loopback and a thread hammering it until destroyed.
+ */
+class loopback_source
+{
+public:
+    explicit loopback_source(const int type)
+    {
+        sockaddr_in address{};
+        address.sin_family      = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length        = sizeof(address);
+
+        if (type == SOCK_DGRAM)
+        {
+            receiver_ = socket(AF_INET, SOCK_DGRAM, 0);
+            int buffer = 1 << 24;
+            setsockopt(receiver_, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+            bind(receiver_, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+            getsockname(receiver_, reinterpret_cast<sockaddr *>(&address), &length);
+            sender_ = socket(AF_INET, SOCK_DGRAM, 0);
+            connect(sender_, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+        }
+        else
+        {
+            const int listener = socket(AF_INET, SOCK_STREAM, 0);
+            bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+            getsockname(listener, reinterpret_cast<sockaddr *>(&address), &length);
+            listen(listener, 1);
+            sender_ = socket(AF_INET, SOCK_STREAM, 0);
+            connect(sender_, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+            receiver_ = accept(listener, nullptr, nullptr);
+            close(listener);
+        }
+
+        thread_ = std::thread([this] {
+            message_type message{};
+            while (!stop_.load(std::memory_order::relaxed))
+            {
+                // udp sends fail while the receive buffer is full, the stream blocks until read
+                if (send(sender_, message.data(), message.size(), MSG_NOSIGNAL) < 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    ~loopback_source()
+    {
+        stop_.store(true, std::memory_order::relaxed);
+        shutdown(sender_, SHUT_RDWR);
+        thread_.join();
+        close(sender_);
+        close(receiver_);
+    }
+
+    loopback_source(const loopback_source &)            = delete;
+    loopback_source &operator=(const loopback_source &) = delete;
+    loopback_source(loopback_source &&)                 = delete;
+    loopback_source &operator=(loopback_source &&)      = delete;
+
+    [[nodiscard]] int receiver() const noexcept
+    {
+        return receiver_;
+    }
+
+private:
+    int sender_   = -1;
+    int receiver_ = -1;
+    std::atomic<bool> stop_ = false;
+    std::thread thread_;
+};
+
+/*
+ * `copies` is every copy of a message's bytes the reader made, counted where it happens, the kernel's copy out of
+ * the socket included.
+ */
+void report(benchmark::State &state, const std::int64_t messages, const std::int64_t bytes, const std::int64_t copies)
+{
+    state.SetItemsProcessed(messages);
+    state.SetBytesProcessed(bytes);
+    state.counters["copies_per_msg"] = static_cast<double>(copies) / static_cast<double>(messages);
+}
+
+} // namespace
+
+/*
+ * the usual reader, recv into a scratch buffer and copy the message into the ring for the consumer, which copies it
+ * out again.
+ */
+static void bm_recv_copy(benchmark::State &state)
+{
+    loopback_source source(static_cast<int>(state.range(0)));
+    auto ring = std::make_unique<jc::lockfree::cached_spsc<message_type, 1024>>();
+
+    std::int64_t bytes  = 0;
+    std::int64_t copies = 0;
+    message_type scratch;
+    for (auto _ : state)
+    {
+        for (std::int64_t received = 0; received < batch; received++)
+        {
+            const ssize_t size = recv(source.receiver(), scratch.data(), scratch.size(), 0);
+            if (size < 0)
+            {
+                state.SkipWithError("recv failed");
+                return;
+            }
+            ring->put(scratch);
+            const message_type message = ring->read();
+            benchmark::DoNotOptimize(message[0]);
+            bytes += size;
+            // socket to scratch, scratch to slot, slot to the consumer
+            copies += 3;
+        }
+    }
+    report(state, state.iterations() * batch, bytes, copies);
+}
+
+static void bm_ingest(benchmark::State &state)
+{
+    loopback_source source(static_cast<int>(state.range(0)));
+    jc::memory::base_allocator arena(8 << 20);
+    auto ingest = std::make_unique<ingest_type>(arena, static_cast<jc::io::ingest_backend>(state.range(1)));
+    // datagrams can have several receives in flight, a stream must keep its bytes in order
+    if (!ingest->successful_init() || !ingest->add_socket(source.receiver(), state.range(0) == SOCK_DGRAM ? 64 : 1))
+    {
+        state.SkipWithError("could not set up the ingest");
+        return;
+    }
+
+    std::int64_t messages = 0;
+    std::int64_t bytes    = 0;
+    std::int64_t copies   = 0;
+    for (auto _ : state)
+    {
+        std::int64_t received = 0;
+        while (received < batch)
+        {
+            ingest->poll(true);
+            while (std::optional<jc::io::ingest_buffer> buffer = ingest->try_read())
+            {
+                const std::span<const std::byte> message = ingest->data(*buffer);
+                benchmark::DoNotOptimize(message[0]);
+                bytes += static_cast<std::int64_t>(message.size());
+                // socket to the pool buffer, the consumer reads it in place
+                copies += 1;
+                ingest->release(*buffer);
+                ++received;
+            }
+        }
+        messages += received;
+    }
+    report(state, messages, bytes, copies);
+    state.SetLabel(ingest->backend() == jc::io::ingest_backend::io_uring ? "io_uring" : "epoll");
+}
+
+static constexpr int uring_backend = static_cast<int>(jc::io::ingest_backend::io_uring);
+static constexpr int epoll_backend = static_cast<int>(jc::io::ingest_backend::epoll);
+
+BENCHMARK(bm_recv_copy)->ArgName("type")->Arg(SOCK_DGRAM)->Arg(SOCK_STREAM)->UseRealTime();
+BENCHMARK(bm_ingest)
+    ->ArgNames({"type", "backend"})
+    ->ArgsProduct({{SOCK_DGRAM, SOCK_STREAM}, {uring_backend, epoll_backend}})
+    ->UseRealTime();
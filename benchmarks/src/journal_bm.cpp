@@ -0,0 +1,189 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/io/journal.hpp>
+#include <jc_collections/lockfree/spsc.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct order_event
+{
+    std::uint64_t order_id;
+    std::uint64_t instrument;
+    double price;
+    double quantity;
+};
+
+using writer_type = jc::io::journal_writer<order_event, 1 << 16>;
+
+// records per iteration of the sustained benchmark
+constexpr std::uint64_t sustained_count = 1 << 20;
+// calls timed individually when measuring the producer's latency distribution
+constexpr std::size_t latency_samples = 1 << 16;
+
+class scratch_directory
+{
+public:
+    scratch_directory() : path_(std::filesystem::temp_directory_path() / "jc_journal_bm")
+    {
+        std::filesystem::create_directories(path_);
+    }
+
+    ~scratch_directory()
+    {
+        std::error_code ignored;
+        std::filesystem::remove_all(path_, ignored);
+    }
+
+    scratch_directory(const scratch_directory &)            = delete;
+    scratch_directory &operator=(const scratch_directory &) = delete;
+    scratch_directory(scratch_directory &&)                 = delete;
+    scratch_directory &operator=(scratch_directory &&)      = delete;
+
+    [[nodiscard]] const std::filesystem::path &path() const noexcept
+    {
+        return path_;
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+void percentiles(benchmark::State &state, std::vector<std::int64_t> &samples)
+{
+    std::sort(samples.begin(), samples.end());
+    state.counters["p50_ns"]  = static_cast<double>(samples[samples.size() / 2]);
+    state.counters["p99_ns"]  = static_cast<double>(samples[samples.size() * 99 / 100]);
+    state.counters["p999_ns"] = static_cast<double>(samples[samples.size() * 999 / 1000]);
+}
+
+} // namespace
+
+/*
+ * end to end, how fast records reach the mapped segments when the producer retries instead of dropping.
+ */
+static void bm_journal_sustained(benchmark::State &state)
+{
+    scratch_directory directory;
+    for (auto _ : state)
+    {
+        auto writer = std::make_unique<writer_type>(directory.path(), "orders");
+        writer->start();
+        for (std::uint64_t i = 0; i < sustained_count; i++)
+        {
+            while (!writer->record(order_event{i, i & 63, 100.0 + static_cast<double>(i & 7), 1.0}))
+            {
+            }
+        }
+        writer->stop();
+        benchmark::DoNotOptimize(writer->written());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(sustained_count));
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(sustained_count) *
+                            static_cast<std::int64_t>(sizeof(writer_type::record_type)));
+}
+
+/*
+ * producer cost of handing an event to a consumer thread that discards it, the floor for any off-thread sink.
+ */
+static void bm_producer_latency_ring(benchmark::State &state)
+{
+    auto ring = std::make_unique<jc::lockfree::cached_spsc<order_event, 1 << 16>>();
+    std::atomic<bool> stop = false;
+    std::thread consumer([&] {
+        while (!stop.load(std::memory_order::relaxed))
+        {
+            benchmark::DoNotOptimize(ring->try_read());
+        }
+    });
+
+    std::vector<std::int64_t> samples(latency_samples);
+    std::uint64_t id = 0;
+    for (auto _ : state)
+    {
+        for (std::int64_t &sample : samples)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            benchmark::DoNotOptimize(ring->try_put(order_event{id++, 1, 100.0, 1.0}));
+            sample = std::chrono::nanoseconds(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+    stop.store(true, std::memory_order::relaxed);
+    consumer.join();
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(latency_samples));
+    percentiles(state, samples);
+}
+
+/*
+ * the same calls going to the journal, the gap to the ring benchmark is what journalling costs the hot thread.
+ */
+static void bm_producer_latency_journal(benchmark::State &state)
+{
+    scratch_directory directory;
+    auto writer = std::make_unique<writer_type>(directory.path(), "orders");
+    writer->start();
+
+    std::vector<std::int64_t> samples(latency_samples);
+    std::uint64_t id = 0;
+    for (auto _ : state)
+    {
+        for (std::int64_t &sample : samples)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            benchmark::DoNotOptimize(writer->record(order_event{id++, 1, 100.0, 1.0}));
+            sample = std::chrono::nanoseconds(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+    writer->stop();
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(latency_samples));
+    state.counters["dropped"] = static_cast<double>(writer->dropped());
+    percentiles(state, samples);
+}
+
+static void bm_journal_replay(benchmark::State &state)
+{
+    scratch_directory directory;
+    {
+        auto writer = std::make_unique<writer_type>(directory.path(), "orders");
+        writer->start();
+        for (std::uint64_t i = 0; i < sustained_count; i++)
+        {
+            while (!writer->record(order_event{i, i & 63, 100.0, 1.0}))
+            {
+            }
+        }
+    }
+
+    auto queue = std::make_unique<jc::lockfree::cached_spsc<order_event, 1 << 16>>();
+    std::atomic<bool> stop = false;
+    std::thread consumer([&] {
+        while (!stop.load(std::memory_order::relaxed))
+        {
+            benchmark::DoNotOptimize(queue->try_read());
+        }
+    });
+
+    for (auto _ : state)
+    {
+        jc::io::journal_reader<order_event> reader(directory.path(), "orders");
+        benchmark::DoNotOptimize(jc::io::replay(reader, *queue, 0.0));
+    }
+    stop.store(true, std::memory_order::relaxed);
+    consumer.join();
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(sustained_count));
+}
+
+BENCHMARK(bm_journal_sustained)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_producer_latency_ring)->UseRealTime();
+BENCHMARK(bm_producer_latency_journal)->UseRealTime();
+BENCHMARK(bm_journal_replay)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/io/logger.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <print>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+std::filesystem::path log_path(const char *name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+/*
+ * what an spdlog style async logger does on the caller: format the message payload into a string, then hand it to a
+ * backend thread through a locked queue.
+ */
+class format_then_enqueue_logger
+{
+public:
+    explicit format_then_enqueue_logger(const std::filesystem::path &path) : file_(std::fopen(path.c_str(), "a"))
+    {
+        backend_ = std::thread([this] {
+            std::deque<std::string> batch;
+            while (true)
+            {
+                {
+                    std::unique_lock lock(mutex_);
+                    ready_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                    if (queue_.empty())
+                    {
+                        return;
+                    }
+                    batch.swap(queue_);
+                }
+                for (const std::string &line : batch)
+                {
+                    std::fwrite(line.data(), 1, line.size(), file_);
+                }
+                batch.clear();
+            }
+        });
+    }
+
+    ~format_then_enqueue_logger()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        ready_.notify_one();
+        backend_.join();
+        std::fclose(file_);
+    }
+
+    format_then_enqueue_logger(const format_then_enqueue_logger &)            = delete;
+    format_then_enqueue_logger &operator=(const format_then_enqueue_logger &) = delete;
+    format_then_enqueue_logger(format_then_enqueue_logger &&)                 = delete;
+    format_then_enqueue_logger &operator=(format_then_enqueue_logger &&)      = delete;
+
+    template <typename... Args>
+    void log(std::format_string<Args...> format, Args &&...args)
+    {
+        std::string line = std::format(format, std::forward<Args>(args)...);
+        line.push_back('\n');
+        {
+            std::lock_guard lock(mutex_);
+            queue_.push_back(std::move(line));
+        }
+        ready_.notify_one();
+    }
+
+private:
+    std::FILE *file_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::string> queue_;
+    bool stop_ = false;
+    std::thread backend_;
+};
+
+} // namespace
+
+static void bm_async_logger(benchmark::State &state)
+{
+    const std::filesystem::path path = log_path("jc_logger_bm.log");
+    {
+        auto logger = std::make_unique<jc::io::async_logger<1 << 22>>(path);
+        logger->start();
+
+        std::int64_t order = 0;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(
+                logger->info<"order {} filled {} @ {} side {}">(order, 100 + (order & 15), 101.25, 'B'));
+            ++order;
+        }
+        logger->stop();
+        state.counters["dropped"] = static_cast<double>(logger->dropped());
+    }
+    std::filesystem::remove(path);
+}
+
+static void bm_format_then_enqueue(benchmark::State &state)
+{
+    const std::filesystem::path path = log_path("jc_logger_bm_queue.log");
+    {
+        format_then_enqueue_logger logger(path);
+
+        std::int64_t order = 0;
+        for (auto _ : state)
+        {
+            logger.log("order {} filled {} @ {} side {}", order, 100 + (order & 15), 101.25, 'B');
+            ++order;
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+static void bm_println(benchmark::State &state)
+{
+    const std::filesystem::path path = log_path("jc_logger_bm_println.log");
+    std::FILE *file = std::fopen(path.c_str(), "a");
+
+    std::int64_t order = 0;
+    for (auto _ : state)
+    {
+        std::println(file, "order {} filled {} @ {} side {}", order, 100 + (order & 15), 101.25, 'B');
+        ++order;
+    }
+    std::fclose(file);
+    std::filesystem::remove(path);
+}
+
+BENCHMARK(bm_async_logger);
+BENCHMARK(bm_format_then_enqueue);
+BENCHMARK(bm_println);
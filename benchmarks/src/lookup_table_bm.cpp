@@ -0,0 +1,231 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/collections/lookup_table.hpp>
+#include <jc_collections/memory/base_allocator.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+ * Startup cost and first lookup latency of two precomputed tables, a 4096 symbol map (packed 8 character symbols to
+ * instrument ids, generated out of order) and a 1024 band tick size ladder, built three ways: a std::map at startup
+ * (what we do today), a lookup_table built at startup into a base_allocator, and a lookup_table built by the
+ * compiler into .rodata.
+ *
+ * Startup is computing the entries, building both tables and one lookup in each. For the static tables only the
+ * lookup is left, so before each run their pages are dropped with madvise and the time is the page faults bringing
+ * them back from the page cache, which is what a freshly started process pays. First lookup is one find on a table
+ * that is already built, after the caches have been flushed by walking a buffer much larger than the LLC.
+ */
+namespace
+{
+
+constexpr std::size_t symbol_count = 4096;
+constexpr std::size_t band_count   = 1024;
+constexpr std::size_t evict_bytes  = 64 << 20;
+
+using symbol_entries = std::array<std::pair<u64, u32>, symbol_count>;
+using ladder_entries = std::array<std::pair<i64, i64>, band_count>;
+
+constexpr u64 pack_symbol(std::size_t id) noexcept
+{
+    u64 packed = 0;
+    for (std::size_t c = 0; c < 8; c++)
+    {
+        packed = packed << 8 | ('A' + id % 26);
+        id /= 26;
+    }
+    return packed;
+}
+
+/*
+ * the generators take the entry count so the runtime builds can pass one the optimizer can't see, otherwise it
+ * computes the entries itself and the startup runs only time copying them.
+ */
+constexpr symbol_entries make_symbols(const std::size_t count = symbol_count) noexcept
+{
+    symbol_entries entries{};
+    for (std::size_t i = 0; i < count; i++)
+    {
+        // an odd multiplier permutes the ids, so the entries don't arrive sorted
+        const std::size_t id = (i * 2654435761U) % symbol_count;
+        entries[i]           = {pack_symbol(id * 7919), static_cast<u32>(id)};
+    }
+    return entries;
+}
+
+constexpr ladder_entries make_ladder(const std::size_t count = band_count) noexcept
+{
+    ladder_entries entries{};
+    i64 lower = 0;
+    for (std::size_t band = 0; band < count; band++)
+    {
+        const i64 tick = i64{1} << (band / 128);
+        entries[band]  = {lower, tick};
+        lower += tick * 1000;
+    }
+    return entries;
+}
+
+alignas(4096) constexpr auto static_symbols = jc::collections::make_static_lookup_table(make_symbols());
+alignas(4096) constexpr auto static_ladder  = jc::collections::make_static_lookup_table(make_ladder());
+static_assert(static_symbols.successful_init() && static_ladder.successful_init());
+
+/*
+ * drops the whole pages of `object` so the next access faults them back in, false if the kernel refused.
+ */
+template <typename T>
+bool drop_pages(const T &object) noexcept
+{
+    const auto page  = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const auto bytes = sizeof(T) / page * page;
+    return madvise(const_cast<T *>(&object), bytes, MADV_DONTNEED) == 0;
+}
+
+void evict_caches() noexcept
+{
+    static std::vector<u8> buffer(evict_bytes);
+    for (std::size_t i = 0; i < buffer.size(); i += 64)
+    {
+        buffer[i]++;
+    }
+    benchmark::ClobberMemory();
+}
+
+u64 probe_symbol(const std::size_t i) noexcept
+{
+    u64 symbol = pack_symbol((i % symbol_count) * 7919);
+    benchmark::DoNotOptimize(symbol);
+    return symbol;
+}
+
+i64 probe_price(const std::size_t i) noexcept
+{
+    i64 price = static_cast<i64>(i * 7919 % (band_count * 1000));
+    benchmark::DoNotOptimize(price);
+    return price;
+}
+
+template <std::size_t count>
+std::size_t opaque_count() noexcept
+{
+    std::size_t n = count;
+    benchmark::DoNotOptimize(n);
+    return n;
+}
+
+double seconds_since(const std::chrono::steady_clock::time_point start) noexcept
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void bm_startup_std_map(benchmark::State &state)
+{
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto start             = std::chrono::steady_clock::now();
+        const symbol_entries symbols = make_symbols(opaque_count<symbol_count>());
+        const ladder_entries ladder  = make_ladder(opaque_count<band_count>());
+        std::map<u64, u32> symbol_map(symbols.begin(), symbols.end());
+        std::map<i64, i64> ladder_map(ladder.begin(), ladder.end());
+        benchmark::DoNotOptimize(symbol_map.find(probe_symbol(i))->second);
+        benchmark::DoNotOptimize(std::prev(ladder_map.upper_bound(probe_price(i)))->second);
+        state.SetIterationTime(seconds_since(start));
+        i++;
+    }
+}
+
+void bm_startup_arena_table(benchmark::State &state)
+{
+    jc::memory::base_allocator arena(1 << 20);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        arena.reset();
+        const auto start             = std::chrono::steady_clock::now();
+        const symbol_entries symbols = make_symbols(opaque_count<symbol_count>());
+        const ladder_entries ladder  = make_ladder(opaque_count<band_count>());
+        const jc::collections::arena_lookup_table<u64, u32> symbol_table(symbols, arena);
+        const jc::collections::arena_lookup_table<i64, i64> ladder_table(ladder, arena);
+        benchmark::DoNotOptimize(*symbol_table.find(probe_symbol(i)));
+        benchmark::DoNotOptimize(*ladder_table.floor(probe_price(i)));
+        state.SetIterationTime(seconds_since(start));
+        i++;
+    }
+}
+
+void bm_startup_static_table(benchmark::State &state)
+{
+    bool dropped  = true;
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        dropped          = drop_pages(static_symbols) && drop_pages(static_ladder) && dropped;
+        const auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(*static_symbols.find(probe_symbol(i)));
+        benchmark::DoNotOptimize(*static_ladder.floor(probe_price(i)));
+        state.SetIterationTime(seconds_since(start));
+        i++;
+    }
+    state.counters["pages_dropped"] = dropped ? 1 : 0;
+    state.counters["rodata_kib"]    = static_cast<double>(sizeof(static_symbols) + sizeof(static_ladder)) / 1024;
+}
+
+// the runtime built tables for the first lookup runs, built once at static initialization
+const symbol_entries runtime_symbols = make_symbols(opaque_count<symbol_count>());
+const ladder_entries runtime_ladder  = make_ladder(opaque_count<band_count>());
+const std::map<u64, u32> symbol_map(runtime_symbols.begin(), runtime_symbols.end());
+const std::map<i64, i64> ladder_map(runtime_ladder.begin(), runtime_ladder.end());
+jc::memory::base_allocator table_arena(1 << 20);
+const jc::collections::arena_lookup_table<u64, u32> symbol_table(runtime_symbols, table_arena);
+const jc::collections::arena_lookup_table<i64, i64> ladder_table(runtime_ladder, table_arena);
+
+void lookup_std_map(const std::size_t i) noexcept
+{
+    benchmark::DoNotOptimize(symbol_map.find(probe_symbol(i))->second);
+    benchmark::DoNotOptimize(std::prev(ladder_map.upper_bound(probe_price(i)))->second);
+}
+
+void lookup_arena_table(const std::size_t i) noexcept
+{
+    benchmark::DoNotOptimize(*symbol_table.find(probe_symbol(i)));
+    benchmark::DoNotOptimize(*ladder_table.floor(probe_price(i)));
+}
+
+void lookup_static_table(const std::size_t i) noexcept
+{
+    benchmark::DoNotOptimize(*static_symbols.find(probe_symbol(i)));
+    benchmark::DoNotOptimize(*static_ladder.floor(probe_price(i)));
+}
+
+/*
+ * one symbol lookup and one ladder lookup on built tables with cold caches.
+ */
+void bm_first_lookup(benchmark::State &state, void (*lookup)(std::size_t) noexcept)
+{
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        evict_caches();
+        const auto start = std::chrono::steady_clock::now();
+        lookup(i++);
+        state.SetIterationTime(seconds_since(start));
+    }
+}
+
+} // namespace
+
+BENCHMARK(bm_startup_std_map)->UseManualTime();
+BENCHMARK(bm_startup_arena_table)->UseManualTime();
+// the timed part is tiny next to dropping pages and flushing caches, left alone benchmark would run these for ages
+BENCHMARK(bm_startup_static_table)->UseManualTime()->Iterations(1000);
+BENCHMARK_CAPTURE(bm_first_lookup, std_map, lookup_std_map)->UseManualTime()->Iterations(200);
+BENCHMARK_CAPTURE(bm_first_lookup, arena_table, lookup_arena_table)->UseManualTime()->Iterations(200);
+BENCHMARK_CAPTURE(bm_first_lookup, static_table, lookup_static_table)->UseManualTime()->Iterations(200);
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/lockfree/pipeline.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct increment_stage
+{
+    using input_type  = std::uint64_t;
+    using output_type = std::uint64_t;
+
+    bool operator()(const std::uint64_t in, std::uint64_t &out) const noexcept
+    {
+        out = in + 1;
+        return true;
+    }
+};
+
+template <std::size_t n, typename... Stages>
+struct repeat_stages : repeat_stages<n - 1, Stages..., increment_stage>
+{
+};
+
+template <typename... Stages>
+struct repeat_stages<0, Stages...>
+{
+    using type = jc::lockfree::pipeline<1024, 64, Stages...>;
+};
+
+// elements per benchmark iteration, large enough that filling and draining the pipeline is noise
+constexpr std::uint64_t block = 1 << 16;
+
+template <std::size_t stages>
+void bm_pipeline(benchmark::State &state)
+{
+    using pipeline_type = typename repeat_stages<stages>::type;
+    auto pipeline       = std::make_unique<pipeline_type>();
+
+    // the benchmark thread feeds and drains on core 0, stages take the cores after it
+    std::vector<int> cores(stages);
+    std::iota(cores.begin(), cores.end(), 1);
+    const unsigned available = std::thread::hardware_concurrency();
+    if (available <= stages)
+    {
+        cores.clear();
+    }
+    if (!pipeline->start(cores))
+    {
+        state.SkipWithError("could not start the stage threads");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        std::uint64_t sent     = 0;
+        std::uint64_t received = 0;
+        while (received < block)
+        {
+            if (sent < block && pipeline->input().try_put(std::uint64_t{sent}))
+            {
+                ++sent;
+            }
+            if (std::optional<std::uint64_t> value = pipeline->output().try_read())
+            {
+                benchmark::DoNotOptimize(*value);
+                ++received;
+            }
+        }
+    }
+    pipeline->stop();
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(block));
+    for (std::size_t i = 0; i < stages; i++)
+    {
+        const jc::lockfree::stage_stats stats = pipeline->stats(i);
+        const double polls = static_cast<double>(stats.busy_polls_ + stats.idle_polls_);
+        const std::string prefix = "stage" + std::to_string(i);
+        state.counters[prefix + "_busy"]  = polls > 0 ? static_cast<double>(stats.busy_polls_) / polls : 0.0;
+        state.counters[prefix + "_batch"] =
+            stats.busy_polls_ > 0 ? static_cast<double>(stats.items_) / static_cast<double>(stats.busy_polls_) : 0.0;
+    }
+}
+
+} // namespace
+
+BENCHMARK(bm_pipeline<1>)->UseRealTime();
+BENCHMARK(bm_pipeline<2>)->UseRealTime();
+BENCHMARK(bm_pipeline<4>)->UseRealTime();
+BENCHMARK(bm_pipeline<8>)->UseRealTime();
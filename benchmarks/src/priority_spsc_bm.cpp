@@ -0,0 +1,218 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/lockfree/priority_spsc.hpp>
+#include <jc_collections/lockfree/spsc.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <thread>
+
+namespace
+{
+
+enum class order_kind : u8
+{
+    new_order,
+    cancel,
+};
+
+struct order_message
+{
+    order_kind kind_;
+    u64 order_id_;
+    i64 sent_ns_;
+};
+
+constexpr std::size_t lane_size   = 4096;
+constexpr std::size_t cancel_lane = 0;
+constexpr std::size_t order_lane  = 1;
+
+i64 now_ns() noexcept
+{
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+/*
+ * a little work per message so the consumer is the bottleneck, like a gateway that is backed up.
+ */
+void handle(const order_message &message) noexcept
+{
+    u64 hash = message.order_id_;
+    for (int i = 0; i < 16; i++)
+    {
+        hash = hash * 0x9E3779B97F4A7C15ULL + 1;
+    }
+    benchmark::DoNotOptimize(hash);
+}
+
+/*
+ * head-of-line latency, single threaded so it is exact: the order lane holds `backlog` new orders, a cancel is
+ * published and the consumer handles messages until it reaches the cancel. With one FIFO ring the cancel waits for the
+ * whole backlog, with lanes it is served next.
+ */
+void bm_fifo_cancel_latency(benchmark::State &state)
+{
+    const auto backlog = static_cast<std::size_t>(state.range(0));
+    auto queue         = std::make_unique<jc::lockfree::cached_spsc<order_message, lane_size>>();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (std::size_t i = 0; i < backlog; i++)
+        {
+            queue->put(order_message{order_kind::new_order, i, 0});
+        }
+        state.ResumeTiming();
+
+        queue->put(order_message{order_kind::cancel, backlog, now_ns()});
+        while (true)
+        {
+            const order_message message = queue->read();
+            handle(message);
+            if (message.kind_ == order_kind::cancel)
+            {
+                break;
+            }
+        }
+    }
+}
+
+void bm_priority_cancel_latency(benchmark::State &state)
+{
+    const auto backlog = static_cast<std::size_t>(state.range(0));
+    auto queue         = std::make_unique<jc::lockfree::priority_spsc<order_message, 2, lane_size>>();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        // whatever is left of the last backlog stays queued, top it back up
+        while (queue->try_read())
+        {
+        }
+        for (std::size_t i = 0; i < backlog; i++)
+        {
+            queue->put(order_lane, order_message{order_kind::new_order, i, 0});
+        }
+        state.ResumeTiming();
+
+        queue->put(cancel_lane, order_message{order_kind::cancel, backlog, now_ns()});
+        while (true)
+        {
+            const order_message message = queue->read();
+            handle(message);
+            if (message.kind_ == order_kind::cancel)
+            {
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * two threads: the producer keeps the order lane saturated and sends a cancel every `cancel_every` orders, the
+ * consumer records how long each cancel took from publish to being handled.
+ */
+template <bool lanes>
+void bm_saturated_cancel_latency(benchmark::State &state)
+{
+    using fifo_type     = jc::lockfree::cached_spsc<order_message, lane_size>;
+    using priority_type = jc::lockfree::priority_spsc<order_message, 2, lane_size>;
+    constexpr u64 cancel_every = 256;
+    auto fifo                  = std::make_unique<fifo_type>();
+    auto priority              = std::make_unique<priority_type>();
+
+    std::atomic<bool> stop = false;
+    std::thread producer([&] {
+        for (u64 i = 0; !stop.load(std::memory_order::relaxed); i++)
+        {
+            const bool cancel = i % cancel_every == 0;
+            order_message message{cancel ? order_kind::cancel : order_kind::new_order, i, cancel ? now_ns() : 0};
+            if constexpr (lanes)
+            {
+                while (!priority->try_put(cancel ? cancel_lane : order_lane, std::move(message)) &&
+                       !stop.load(std::memory_order::relaxed))
+                {
+                }
+            }
+            else
+            {
+                while (!fifo->try_put(std::move(message)) && !stop.load(std::memory_order::relaxed))
+                {
+                }
+            }
+        }
+    });
+
+    i64 total_ns = 0;
+    i64 worst_ns = 0;
+    u64 cancels  = 0;
+    for (auto _ : state)
+    {
+        std::optional<order_message> message;
+        if constexpr (lanes)
+        {
+            message = priority->try_read();
+        }
+        else
+        {
+            message = fifo->try_read();
+        }
+        if (!message)
+        {
+            continue;
+        }
+        handle(*message);
+        if (message->kind_ == order_kind::cancel)
+        {
+            const i64 latency = now_ns() - message->sent_ns_;
+            total_ns += latency;
+            worst_ns = std::max(worst_ns, latency);
+            ++cancels;
+        }
+    }
+    stop.store(true, std::memory_order::relaxed);
+    producer.join();
+
+    state.counters["cancel_mean_ns"] =
+        cancels == 0 ? 0 : static_cast<double>(total_ns) / static_cast<double>(cancels);
+    state.counters["cancel_worst_ns"] = static_cast<double>(worst_ns);
+    state.counters["cancels"]         = static_cast<double>(cancels);
+}
+
+/*
+ * what the lanes cost at worst: every read drains its lane, so each one also pays for clearing the lane's bit.
+ */
+void bm_fifo_round_trip(benchmark::State &state)
+{
+    auto queue = std::make_unique<jc::lockfree::cached_spsc<order_message, lane_size>>();
+    u64 i      = 0;
+    for (auto _ : state)
+    {
+        queue->put(order_message{order_kind::new_order, i++, 0});
+        benchmark::DoNotOptimize(queue->read());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void bm_priority_round_trip(benchmark::State &state)
+{
+    auto queue = std::make_unique<jc::lockfree::priority_spsc<order_message, 4, lane_size>>();
+    u64 i      = 0;
+    for (auto _ : state)
+    {
+        queue->put(i % 4, order_message{order_kind::new_order, i, 0});
+        benchmark::DoNotOptimize(queue->read());
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK(bm_fifo_cancel_latency)->Arg(0)->Arg(64)->Arg(1024)->Arg(4000);
+BENCHMARK(bm_priority_cancel_latency)->Arg(0)->Arg(64)->Arg(1024)->Arg(4000);
+BENCHMARK_TEMPLATE(bm_saturated_cancel_latency, false)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_saturated_cancel_latency, true)->UseRealTime();
+BENCHMARK(bm_fifo_round_trip);
+BENCHMARK(bm_priority_round_trip);
@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/lockfree/seqlock.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+
+namespace
+{
+
+struct top_of_book
+{
+    double bid_;
+    double ask_;
+    long long bid_size_;
+    long long ask_size_;
+    long long sequence_;
+};
+
+class shared_mutex_cell
+{
+public:
+    void store(const top_of_book &value)
+    {
+        std::unique_lock lock(mutex_);
+        value_ = value;
+    }
+
+    top_of_book load() const
+    {
+        std::shared_lock lock(mutex_);
+        return value_;
+    }
+
+private:
+    mutable std::shared_mutex mutex_;
+    top_of_book value_{};
+};
+
+/*
+ * thread 0 is the writer and reports its per store latency, every other thread is a reader.
+ */
+template <typename Cell>
+void run_cell(benchmark::State &state, Cell &cell)
+{
+    if (state.thread_index() == 0)
+    {
+        long long seq    = 0;
+        double writer_ns = 0;
+        for (auto _ : state)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            cell.store(top_of_book{1.0, 1.5, 100, 200, ++seq});
+            const auto stop = std::chrono::steady_clock::now();
+            writer_ns += std::chrono::duration<double, std::nano>(stop - start).count();
+        }
+        // only the writer sets this counter, so the per thread sum is the writer's mean latency
+        state.counters["writer_ns"] = writer_ns / static_cast<double>(state.iterations());
+    }
+    else
+    {
+        for (auto _ : state)
+        {
+            top_of_book snapshot = cell.load();
+            benchmark::DoNotOptimize(snapshot);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+} // namespace
+
+static void bm_seqlock(benchmark::State &state)
+{
+    static jc::lockfree::seqlock<top_of_book> cell;
+    run_cell(state, cell);
+}
+
+static void bm_versioned_seqlock(benchmark::State &state)
+{
+    static jc::lockfree::versioned_seqlock<top_of_book, 8> cell;
+    run_cell(state, cell);
+}
+
+static void bm_shared_mutex(benchmark::State &state)
+{
+    static shared_mutex_cell cell;
+    run_cell(state, cell);
+}
+
+// one writer plus 1, 2, 4, 8 and 16 readers
+BENCHMARK(bm_seqlock)->Threads(2)->Threads(3)->Threads(5)->Threads(9)->Threads(17)->UseRealTime();
+BENCHMARK(bm_versioned_seqlock)->Threads(2)->Threads(3)->Threads(5)->Threads(9)->Threads(17)->UseRealTime();
+BENCHMARK(bm_shared_mutex)->Threads(2)->Threads(3)->Threads(5)->Threads(9)->Threads(17)->UseRealTime();
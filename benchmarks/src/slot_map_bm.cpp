@@ -0,0 +1,174 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/memory/base_allocator.hpp>
+#include <jc_collections/memory/slot_map.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+struct session
+{
+    std::uint64_t id;
+    std::uint64_t sequence;
+    double exposure;
+    double limit;
+};
+
+constexpr std::size_t lookups = 1 << 16;
+
+/*
+ * half the sessions are closed again so both structures hold a realistically fragmented population.
+ */
+template <typename Handle>
+std::vector<Handle> populate(jc::memory::slot_map<session, Handle> &map, const std::size_t count)
+{
+    std::vector<Handle> handles;
+    for (std::size_t i = 0; i < count * 2; i++)
+    {
+        handles.push_back(map.emplace(session{i, 0, 0.0, 1e6}));
+    }
+    std::vector<Handle> live;
+    for (std::size_t i = 0; i < handles.size(); i++)
+    {
+        if (i % 2 == 0)
+        {
+            map.erase(handles[i]);
+        }
+        else
+        {
+            live.push_back(handles[i]);
+        }
+    }
+    return live;
+}
+
+std::vector<std::uint64_t> populate(std::unordered_map<std::uint64_t, std::unique_ptr<session>> &map,
+                                    const std::size_t count)
+{
+    std::vector<std::uint64_t> live;
+    for (std::uint64_t i = 0; i < count * 2; i++)
+    {
+        map.emplace(i, std::make_unique<session>(session{i, 0, 0.0, 1e6}));
+    }
+    for (std::uint64_t i = 0; i < count * 2; i++)
+    {
+        if (i % 2 == 0)
+        {
+            map.erase(i);
+        }
+        else
+        {
+            live.push_back(i);
+        }
+    }
+    return live;
+}
+
+template <typename Key>
+std::vector<Key> random_probes(const std::vector<Key> &keys)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<std::size_t> pick(0, keys.size() - 1);
+    std::vector<Key> probes(lookups);
+    std::generate(probes.begin(), probes.end(), [&] { return keys[pick(rng)]; });
+    return probes;
+}
+
+} // namespace
+
+template <typename Handle>
+static void bm_slot_map_lookup(benchmark::State &state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    jc::memory::base_allocator arena(count * 2 * 64 + (1 << 20));
+    jc::memory::slot_map<session, Handle> map(count * 2, arena);
+    const auto probes = random_probes(populate(map, count));
+
+    for (auto _ : state)
+    {
+        for (const Handle handle : probes)
+        {
+            benchmark::DoNotOptimize(map.get(handle)->exposure += 1.0);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(lookups));
+}
+
+static void bm_unordered_map_lookup(benchmark::State &state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::unordered_map<std::uint64_t, std::unique_ptr<session>> map;
+    const auto probes = random_probes(populate(map, count));
+
+    for (auto _ : state)
+    {
+        for (const std::uint64_t id : probes)
+        {
+            benchmark::DoNotOptimize(map.find(id)->second->exposure += 1.0);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(lookups));
+}
+
+static void bm_slot_map_iterate(benchmark::State &state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    jc::memory::base_allocator arena(count * 2 * 64 + (1 << 20));
+    jc::memory::slot_map<session, jc::memory::handle32> map(count * 2, arena);
+    populate(map, count);
+
+    for (auto _ : state)
+    {
+        double total = 0;
+        for (const session &entry : map)
+        {
+            total += entry.exposure;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+}
+
+static void bm_unordered_map_iterate(benchmark::State &state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::unordered_map<std::uint64_t, std::unique_ptr<session>> map;
+    populate(map, count);
+
+    for (auto _ : state)
+    {
+        double total = 0;
+        for (const auto &[id, entry] : map)
+        {
+            total += entry->exposure;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+}
+
+static void bm_concurrent_pool_churn(benchmark::State &state)
+{
+    static jc::memory::concurrent_slot_pool<session> pool(1 << 16);
+
+    for (auto _ : state)
+    {
+        const auto handle = pool.acquire(session{1, 0, 0.0, 1e6});
+        benchmark::DoNotOptimize(pool.get(handle));
+        pool.release(handle);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bm_slot_map_lookup<jc::memory::handle32>)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(bm_slot_map_lookup<jc::memory::handle64>)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(bm_unordered_map_lookup)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(bm_slot_map_iterate)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(bm_unordered_map_iterate)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(bm_concurrent_pool_churn)->ThreadRange(1, 8)->UseRealTime();
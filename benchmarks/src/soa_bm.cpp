@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/collections/soa_vector.hpp>
+#include <jc_collections/memory/base_allocator.hpp>
+
+#include <numeric>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t row_count = 10'000'000;
+
+struct position
+{
+    double price_;
+    double quantity_;
+    int instrument_;
+    int account_;
+    long long timestamp_;
+};
+
+using position_soa = jc::collections::soa_vector<double, double, int, int, long long>;
+
+constexpr std::size_t price_col      = 0;
+constexpr std::size_t quantity_col   = 1;
+constexpr std::size_t instrument_col = 2;
+
+std::vector<position> &aos_rows()
+{
+    static std::vector<position> rows = [] {
+        std::vector<position> result(row_count);
+        for (std::size_t i = 0; i < row_count; i++)
+        {
+            result[i] = position{static_cast<double>(i % 1000), static_cast<double>(i % 7), static_cast<int>(i % 64),
+                                 static_cast<int>(i % 3), static_cast<long long>(i)};
+        }
+        return result;
+    }();
+    return rows;
+}
+
+position_soa &soa_rows()
+{
+    // enough room for every column plus alignment slack
+    static jc::memory::base_allocator arena(row_count * sizeof(position) * 2);
+    static position_soa rows = [] {
+        position_soa result(arena, row_count);
+        for (const position &p : aos_rows())
+        {
+            result.push_back(p.price_, p.quantity_, p.instrument_, p.account_, p.timestamp_);
+        }
+        return result;
+    }();
+    return rows;
+}
+
+} // namespace
+
+static void bm_aos_sum_field(benchmark::State &state)
+{
+    const auto &rows = aos_rows();
+    for (auto _ : state)
+    {
+        double sum = 0;
+        for (const position &p : rows)
+        {
+            sum += p.price_;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * row_count);
+}
+
+static void bm_soa_sum_field(benchmark::State &state)
+{
+    const auto &rows = soa_rows();
+    for (auto _ : state)
+    {
+        const auto prices = rows.column<price_col>();
+        double sum        = std::accumulate(prices.begin(), prices.end(), 0.0);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * row_count);
+}
+
+static void bm_aos_filter_field(benchmark::State &state)
+{
+    const auto &rows = aos_rows();
+    for (auto _ : state)
+    {
+        double notional = 0;
+        for (const position &p : rows)
+        {
+            notional += p.instrument_ == 7 ? p.price_ * p.quantity_ : 0.0;
+        }
+        benchmark::DoNotOptimize(notional);
+    }
+    state.SetItemsProcessed(state.iterations() * row_count);
+}
+
+static void bm_soa_filter_field(benchmark::State &state)
+{
+    const auto &rows = soa_rows();
+    for (auto _ : state)
+    {
+        const auto instruments = rows.column<instrument_col>();
+        const auto prices      = rows.column<price_col>();
+        const auto quantities  = rows.column<quantity_col>();
+
+        double notional = 0;
+        for (std::size_t i = 0; i < instruments.size(); i++)
+        {
+            notional += instruments[i] == 7 ? prices[i] * quantities[i] : 0.0;
+        }
+        benchmark::DoNotOptimize(notional);
+    }
+    state.SetItemsProcessed(state.iterations() * row_count);
+}
+
+BENCHMARK(bm_aos_sum_field)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_soa_sum_field)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_aos_filter_field)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_soa_filter_field)->Unit(benchmark::kMillisecond);
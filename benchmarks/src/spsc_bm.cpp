@@ -1,6 +1,7 @@
 #include <benchmark/benchmark.h>
 #include <jc_collections/lockfree/spsc.hpp>
 #include "../include/SPSCQueue.h" // rigtorps queue
+#include "../include/cpu_topology.hpp"
 #include <boost/lockfree/spsc_queue.hpp> // boost
 #include <folly/ProducerConsumerQueue.h> // todo: figure out why this is so high
 #define _GNU_SOURCE
@@ -30,7 +31,7 @@ struct bigger
 
 static void bm_spsc_cached_throughput(benchmark::State &state)
 {
-    const int core_id = (state.thread_index() == 0) ? 2 : 3;
+    const int core_id = jc::bench::pair_cpu(state.thread_index());
 
     set_thread_affinity(core_id);
     static jc::lockfree::cached_spsc<bigger, 512> q;
@@ -56,7 +57,7 @@ static void bm_spsc_cached_throughput(benchmark::State &state)
 
 static void bm_rigtorp_spsc_throughput(benchmark::State &state)
 {
-    const int core_id = (state.thread_index() == 0) ? 2 : 3;
+    const int core_id = jc::bench::pair_cpu(state.thread_index());
 
     set_thread_affinity(core_id);
     static rigtorp::SPSCQueue<bigger> q(512);
@@ -86,7 +87,7 @@ static void bm_rigtorp_spsc_throughput(benchmark::State &state)
 
 static void bm_boost_spsc_throughput(benchmark::State &state)
 {
-    const int core_id = (state.thread_index() == 0) ? 2 : 3;
+    const int core_id = jc::bench::pair_cpu(state.thread_index());
 
     set_thread_affinity(core_id);
     static boost::lockfree::spsc_queue<bigger> q(1024);
@@ -116,7 +117,7 @@ static void bm_boost_spsc_throughput(benchmark::State &state)
 
 static void bm_folly_spsc_throughput(benchmark::State &state)
 {
-    const int core_id = (state.thread_index() == 0) ? 2 : 3;
+    const int core_id = jc::bench::pair_cpu(state.thread_index());
 
     static folly::ProducerConsumerQueue<bigger> q(512);
 
@@ -145,7 +146,7 @@ static void bm_folly_spsc_throughput(benchmark::State &state)
 
 static void bm_spsc_simple_throughput(benchmark::State &state)
 {
-    const int core_id = (state.thread_index() == 0) ? 2 : 3;
+    const int core_id = jc::bench::pair_cpu(state.thread_index());
 
     set_thread_affinity(core_id);
 
@@ -178,7 +179,7 @@ static void bm_rtt_throughput(benchmark::State &state)
 
     if (state.thread_index() == 0)
     {
-        set_thread_affinity(1);
+        set_thread_affinity(jc::bench::pair_cpu(0));
         for (auto _ : state)
         {
             q1.put(T());
@@ -187,7 +188,7 @@ static void bm_rtt_throughput(benchmark::State &state)
     }
     else
     {
-        set_thread_affinity(2);
+        set_thread_affinity(jc::bench::pair_cpu(1));
         for (auto _ : state)
         {
             q2.put(q1.read());
@@ -204,7 +205,7 @@ static void bm_rigtorp_rtt(benchmark::State &state)
 
     if (state.thread_index() == 0)
     {
-        set_thread_affinity(1);
+        set_thread_affinity(jc::bench::pair_cpu(0));
         for (auto _ : state)
         {
             q1.emplace(T());
@@ -216,7 +217,7 @@ static void bm_rigtorp_rtt(benchmark::State &state)
     }
     else
     {
-        set_thread_affinity(2);
+        set_thread_affinity(jc::bench::pair_cpu(1));
         for (auto _ : state)
         {
             while (!q1.front())
@@ -237,7 +238,7 @@ static void bm_boost_rtt(benchmark::State &state)
 
     if (state.thread_index() == 0)
     {
-        set_thread_affinity(1);
+        set_thread_affinity(jc::bench::pair_cpu(0));
         for (auto _ : state)
         {
             T ele;
@@ -249,7 +250,7 @@ static void bm_boost_rtt(benchmark::State &state)
     }
     else
     {
-        set_thread_affinity(2);
+        set_thread_affinity(jc::bench::pair_cpu(1));
         for (auto _ : state)
         {
             T ele;
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/lockfree/spsc_channel.hpp>
+#include <jc_collections/memory/base_allocator.hpp>
+
+#include <memory_resource>
+#include <thread>
+
+namespace
+{
+
+using channel_type = jc::lockfree::spsc_channel<long, 64>;
+
+// round trips per benchmark iteration, enough to amortise spawning the coroutines
+constexpr long round_trips = 10'000;
+
+jc::lockfree::co_task ping(channel_type &out, channel_type &in, const long count)
+{
+    for (long i = 0; i < count; i++)
+    {
+        co_await out.co_put(i);
+        long reply = co_await in.co_read();
+        benchmark::DoNotOptimize(reply);
+    }
+}
+
+jc::lockfree::co_task pong(channel_type &in, channel_type &out, const long count)
+{
+    for (long i = 0; i < count; i++)
+    {
+        co_await out.co_put(co_await in.co_read());
+    }
+}
+
+} // namespace
+
+static void bm_channel_ping_pong_same_thread(benchmark::State &state)
+{
+    // the arena never frees, so recycle frames through a pool on top of it
+    jc::memory::base_allocator arena(1 << 20);
+    std::pmr::unsynchronized_pool_resource frame_pool(&arena);
+    jc::lockfree::frame_resource_scope frames(frame_pool);
+
+    channel_type to_pong;
+    channel_type to_ping;
+    jc::lockfree::coroutine_scheduler scheduler;
+
+    for (auto _ : state)
+    {
+        scheduler.spawn(ping(to_pong, to_ping, round_trips));
+        scheduler.spawn(pong(to_pong, to_ping, round_trips));
+        scheduler.run();
+    }
+    state.SetItemsProcessed(state.iterations() * round_trips);
+}
+
+static void bm_channel_ping_pong_cross_thread(benchmark::State &state)
+{
+    // the arena never frees, so recycle frames through a pool on top of it
+    jc::memory::base_allocator arena(1 << 20);
+    std::pmr::unsynchronized_pool_resource frame_pool(&arena);
+    jc::lockfree::frame_resource_scope frames(frame_pool);
+
+    channel_type to_pong;
+    channel_type to_ping;
+    jc::lockfree::coroutine_scheduler scheduler;
+
+    for (auto _ : state)
+    {
+        std::thread peer([&] {
+            jc::memory::base_allocator peer_arena(1 << 16);
+            std::pmr::unsynchronized_pool_resource peer_pool(&peer_arena);
+            jc::lockfree::frame_resource_scope peer_frames(peer_pool);
+            jc::lockfree::coroutine_scheduler peer_scheduler;
+            peer_scheduler.spawn(pong(to_pong, to_ping, round_trips));
+            peer_scheduler.run();
+        });
+        scheduler.spawn(ping(to_pong, to_ping, round_trips));
+        scheduler.run();
+        peer.join();
+    }
+    state.SetItemsProcessed(state.iterations() * round_trips);
+}
+
+BENCHMARK(bm_channel_ping_pong_same_thread)->UseRealTime();
+BENCHMARK(bm_channel_ping_pong_cross_thread)->UseRealTime();
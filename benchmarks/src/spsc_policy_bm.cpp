@@ -0,0 +1,298 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/lockfree/spsc.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <thread>
+
+/*
+ * Every policy combination of basic_spsc against the hand-written simple_spsc/cached_spsc it replaced, which are kept
+ * here verbatim as the baseline.
+ */
+namespace legacy
+{
+template <typename T, std::size_t sz = 512>
+    requires jc::lockfree::is_power_of_two<sz> && std::is_move_constructible_v<T> && std::is_move_assignable_v<T> &&
+             std::is_trivially_destructible_v<T>
+class simple_spsc
+{
+private:
+    static constexpr std::size_t alignment_size  = std::max(sizeof(T), std::hardware_destructive_interference_size);
+    alignas(64) std::atomic<std::size_t> writer_ = 0;
+    alignas(64) std::atomic<std::size_t> reader_ = 0;
+    alignas(alignment_size) std::array<T, sz> items_;
+
+public:
+    simple_spsc() = default;
+
+    simple_spsc(const simple_spsc &)            = delete;
+    simple_spsc &operator=(const simple_spsc &) = delete;
+    simple_spsc(simple_spsc &&)                 = delete;
+    simple_spsc &operator=(simple_spsc &&)      = delete;
+
+    ~simple_spsc() = default;
+
+    bool try_put(T &&element)
+    {
+        std::size_t idx = writer_.load(std::memory_order::relaxed);
+        if (idx - reader_.load(std::memory_order::acquire) == sz)
+        {
+            return false;
+        }
+        items_[idx & (sz - 1)] = std::move(element);
+        writer_.store(idx + 1, std::memory_order::release);
+        return true;
+    }
+
+    void put(T &&element)
+    {
+        std::size_t idx = writer_.load(std::memory_order::relaxed);
+        while (idx - reader_.load(std::memory_order::acquire) == sz)
+        {
+        }
+        items_[idx & (sz - 1)] = std::move(element);
+        writer_.store(idx + 1, std::memory_order::release);
+    }
+
+    std::optional<T> try_read()
+    {
+        std::size_t idx = reader_.load(std::memory_order::relaxed);
+        if (idx == writer_.load(std::memory_order::acquire))
+        {
+            return {};
+        }
+        T element = std::move(items_[idx & (sz - 1)]);
+        reader_.store(idx + 1, std::memory_order::release);
+        return element;
+    }
+
+    T read()
+    {
+        std::size_t idx = reader_.load(std::memory_order::relaxed);
+        while (idx == writer_.load(std::memory_order::acquire))
+        {
+        }
+        T element = std::move(items_[idx & (sz - 1)]);
+        reader_.store(idx + 1, std::memory_order::release);
+        return element;
+    }
+};
+
+template <typename T, std::size_t sz = 512>
+    requires jc::lockfree::is_power_of_two<sz> && std::is_move_constructible_v<T> && std::is_move_assignable_v<T> &&
+             std::is_trivially_destructible_v<T>
+class cached_spsc
+{
+private:
+    static constexpr std::size_t mask = sz - 1;
+    struct aligned_indexes
+    {
+        std::atomic<std::size_t> idx_ = 0;
+        std::size_t cached_idx_       = 0;
+    };
+
+    static constexpr std::size_t padding_size = std::hardware_destructive_interference_size - sizeof(aligned_indexes);
+
+    alignas(std::hardware_destructive_interference_size) aligned_indexes writer_;
+    alignas(std::hardware_destructive_interference_size) aligned_indexes reader_;
+    uint8_t padding[padding_size]{};
+    std::array<T, sz> items_;
+
+public:
+    cached_spsc() = default;
+    bool try_put(T &&element)
+    {
+        std::size_t idx = writer_.idx_.load(std::memory_order::relaxed);
+        if (idx - writer_.cached_idx_ == sz)
+        {
+            writer_.cached_idx_ = reader_.idx_.load(std::memory_order_acquire);
+        }
+
+        if (idx - writer_.cached_idx_ == sz)
+        {
+            return false;
+        }
+
+        items_[idx & mask] = std::move(element);
+        writer_.idx_.store(idx + 1, std::memory_order::release);
+
+        return true;
+    }
+
+    template <typename... Args>
+    void emplace(Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args &&...>)
+    {
+        auto const idx = writer_.idx_.load(std::memory_order::relaxed);
+
+        while (idx - writer_.cached_idx_ == sz)
+        {
+            writer_.cached_idx_ = reader_.idx_.load(std::memory_order_acquire);
+        }
+
+        new (&items_[idx & mask]) T(std::forward<Args>(args)...);
+        writer_.idx_.store(idx + 1, std::memory_order::release);
+    }
+
+    void put(T &&element) noexcept
+    {
+        emplace(std::move(element));
+    }
+
+    void put(T &element) noexcept
+    {
+        std::size_t idx = writer_.idx_.load(std::memory_order::relaxed);
+        while (idx - writer_.cached_idx_ == sz)
+        {
+            writer_.cached_idx_ = reader_.idx_.load(std::memory_order_acquire);
+        }
+
+        std::memcpy(&items_[idx & mask], &element, sizeof(T));
+        writer_.idx_.store(idx + 1, std::memory_order::release);
+    }
+
+    std::optional<T> try_read()
+    {
+        std::size_t idx = reader_.idx_.load(std::memory_order::relaxed);
+        if (idx == reader_.cached_idx_)
+        {
+            reader_.cached_idx_ = writer_.idx_.load(std::memory_order_acquire);
+        }
+
+        if (idx == reader_.cached_idx_)
+        {
+            return {};
+        }
+
+        T element = std::move(items_[idx & mask]);
+
+        reader_.idx_.store(idx + 1, std::memory_order::release);
+        return element;
+    }
+
+    [[nodiscard]] T read() noexcept
+    {
+        std::size_t idx = reader_.idx_.load(std::memory_order::relaxed);
+        while (idx == reader_.cached_idx_)
+        {
+            reader_.cached_idx_ = writer_.idx_.load(std::memory_order_acquire);
+        }
+
+        T result;
+        __builtin_memcpy(&result, &items_[idx & mask], sizeof(T));
+        reader_.idx_.store(idx + 1, std::memory_order::release);
+        return result;
+    }
+};
+} // namespace legacy
+
+namespace
+{
+using namespace jc::lockfree::spsc_policy;
+using jc::lockfree::basic_spsc;
+
+struct payload
+{
+    u64 values_[4];
+};
+
+constexpr std::size_t ring_size = 1024;
+
+/*
+ * one thread, a put immediately followed by a read, which isolates the instruction cost of each policy.
+ */
+template <typename Queue>
+void bm_round_trip(benchmark::State &state)
+{
+    static Queue queue;
+    u64 i = 0;
+    for (auto _ : state)
+    {
+        queue.put(payload{i, i, i, i});
+        payload value = queue.read();
+        benchmark::DoNotOptimize(value);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/*
+ * one thread fills the ring and drains it again, so the caching policies see full and empty rings.
+ */
+template <typename Queue>
+void bm_burst(benchmark::State &state)
+{
+    static Queue queue;
+    u64 i = 0;
+    for (auto _ : state)
+    {
+        for (std::size_t n = 0; n < ring_size; n++)
+        {
+            queue.put(payload{i, i, i, i});
+        }
+        for (std::size_t n = 0; n < ring_size; n++)
+        {
+            payload value = queue.read();
+            benchmark::DoNotOptimize(value);
+        }
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<i64>(ring_size));
+}
+
+/*
+ * producer and consumer on their own threads.
+ */
+template <typename Queue>
+void bm_throughput(benchmark::State &state)
+{
+    static Queue queue;
+    if (state.thread_index() == 0)
+    {
+        u64 i = 0;
+        for (auto _ : state)
+        {
+            queue.put(payload{i, i, i, i});
+            ++i;
+        }
+    }
+    else
+    {
+        for (auto _ : state)
+        {
+            payload value = queue.read();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename indexing, padding pad = padding::cache_line, typename waiting = spin_wait,
+          typename transfer = move_transfer, typename bounds = bounded>
+using ring = basic_spsc<payload, ring_size, indexing, pad, waiting, transfer, bounds>;
+
+} // namespace
+
+#define JC_SPSC_POLICY_BENCHMARKS(...)                                                                                 \
+    BENCHMARK_TEMPLATE(bm_round_trip, __VA_ARGS__);                                                                    \
+    BENCHMARK_TEMPLATE(bm_burst, __VA_ARGS__);                                                                         \
+    BENCHMARK_TEMPLATE(bm_throughput, __VA_ARGS__)->Threads(2)->UseRealTime()
+
+JC_SPSC_POLICY_BENCHMARKS(legacy::simple_spsc<payload, ring_size>);
+JC_SPSC_POLICY_BENCHMARKS(jc::lockfree::simple_spsc<payload, ring_size>);
+JC_SPSC_POLICY_BENCHMARKS(legacy::cached_spsc<payload, ring_size>);
+JC_SPSC_POLICY_BENCHMARKS(jc::lockfree::cached_spsc<payload, ring_size>);
+JC_SPSC_POLICY_BENCHMARKS(ring<cached_indexes, padding::none>);
+JC_SPSC_POLICY_BENCHMARKS(ring<cached_indexes, padding::double_line>);
+JC_SPSC_POLICY_BENCHMARKS(ring<cached_indexes, padding::cache_line, pause_wait>);
+JC_SPSC_POLICY_BENCHMARKS(ring<cached_indexes, padding::cache_line, yield_wait>);
+JC_SPSC_POLICY_BENCHMARKS(ring<cached_indexes, padding::cache_line, spin_wait, memcpy_transfer>);
+JC_SPSC_POLICY_BENCHMARKS(ring<cached_indexes, padding::cache_line, spin_wait, emplace_transfer>);
+JC_SPSC_POLICY_BENCHMARKS(ring<shared_indexes, padding::cache_line, spin_wait, memcpy_transfer>);
+// the producer can't know the consumer's progress without looking, so unchecked only runs single threaded
+BENCHMARK_TEMPLATE(bm_round_trip, ring<cached_indexes, padding::cache_line, spin_wait, memcpy_transfer, unchecked>);
+BENCHMARK_TEMPLATE(bm_burst, ring<cached_indexes, padding::cache_line, spin_wait, memcpy_transfer, unchecked>);
@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/lockfree/thread_pool.hpp>
+#include "../include/cpu_topology.hpp"
+#include "../include/queue_adapters.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+/*
+ * Throughput of every queue over the message sizes (16B-512B) and ring capacities (64-64K) we actually run with.
+ * Entries are named spsc_sweep/<queue>/<bytes>B/<capacity> and report both items/s and bytes/s, plus the ring's
+ * footprint so the knees can be lined up against the L1/L2/L3 sizes: small elements share a line between the
+ * producer's and consumer's slots, large rings stop fitting in cache and stop being prefetched ahead of the consumer.
+ *
+ * The grid is generated at compile time, one static queue per instantiation.
+ */
+namespace
+{
+
+using element_sizes = std::index_sequence<16, 32, 64, 128, 256, 512>;
+using capacities    = std::index_sequence<64, 256, 1024, 4096, 16384, 65536>;
+
+template <typename Queue, std::size_t bytes, std::size_t capacity>
+void bm_sweep_throughput(benchmark::State &state)
+{
+    static Queue queue;
+    using value_type = jc::bench::payload<bytes>;
+    jc::lockfree::pin_current_thread(jc::bench::pair_cpu(state.thread_index()));
+    if (state.thread_index() == 0)
+    {
+        value_type value{};
+        for (auto _ : state)
+        {
+            value.words_[0]++;
+            queue.push(value);
+        }
+    }
+    else
+    {
+        for (auto _ : state)
+        {
+            value_type value = queue.pop();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<i64>(bytes));
+
+    constexpr auto per_thread = benchmark::Counter::kAvgThreads;
+    state.counters["ring_kib"] = benchmark::Counter(static_cast<double>(bytes * capacity) / 1024.0, per_thread);
+}
+
+template <template <typename, std::size_t> typename Queue, std::size_t bytes, std::size_t capacity>
+void register_one()
+{
+    using queue_type       = Queue<jc::bench::payload<bytes>, capacity>;
+    const std::string name = "spsc_sweep/" + std::string(queue_type::name) + "/" + std::to_string(bytes) + "B/" +
+                             std::to_string(capacity);
+    benchmark::RegisterBenchmark(name.c_str(), bm_sweep_throughput<queue_type, bytes, capacity>)
+        ->Threads(2)
+        ->UseRealTime();
+}
+
+template <template <typename, std::size_t> typename Queue, std::size_t bytes, std::size_t... sizes>
+void register_row(std::index_sequence<sizes...>)
+{
+    (register_one<Queue, bytes, sizes>(), ...);
+}
+
+template <template <typename, std::size_t> typename Queue, std::size_t... bytes>
+void register_grid(std::index_sequence<bytes...>)
+{
+    (register_row<Queue, bytes>(capacities{}), ...);
+}
+
+template <template <typename, std::size_t> typename Queue, std::size_t capacity, std::size_t... bytes>
+void register_column(std::index_sequence<bytes...>)
+{
+    (register_one<Queue, bytes, capacity>(), ...);
+}
+
+/*
+ * the cached_spsc tuning policies across element sizes, against the plain cached_spsc entries of the grid: one ring
+ * that stays in L2 and one that doesn't.
+ */
+template <template <typename, std::size_t> typename Queue>
+void register_tuning()
+{
+    register_column<Queue, 4096>(element_sizes{});
+    register_column<Queue, 65536>(element_sizes{});
+}
+
+bool register_sweep()
+{
+    register_grid<jc::bench::jc_simple>(element_sizes{});
+    register_grid<jc::bench::jc_cached>(element_sizes{});
+    register_grid<jc::bench::jc_unbounded>(element_sizes{});
+    register_grid<jc::bench::rigtorp_queue>(element_sizes{});
+    register_grid<jc::bench::boost_queue>(element_sizes{});
+
+    register_tuning<jc::bench::jc_cached_prefetch>();
+    register_tuning<jc::bench::jc_cached_line_release>();
+    register_tuning<jc::bench::jc_cached_prefetch_line_release>();
+    return true;
+}
+
+[[maybe_unused]] const bool registered = register_sweep();
+
+} // namespace
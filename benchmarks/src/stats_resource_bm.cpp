@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/memory/stats_resource.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+namespace
+{
+
+// a small working set of live blocks so the upstream pool reaches a steady state
+constexpr std::size_t live_blocks = 64;
+
+void churn(benchmark::State &state, std::pmr::memory_resource &resource)
+{
+    const auto bytes = static_cast<std::size_t>(state.range(0));
+    std::array<void *, live_blocks> blocks{};
+    for (void *&block : blocks)
+    {
+        block = resource.allocate(bytes);
+    }
+
+    std::size_t next = 0;
+    for (auto _ : state)
+    {
+        resource.deallocate(blocks[next], bytes);
+        blocks[next] = resource.allocate(bytes);
+        benchmark::DoNotOptimize(blocks[next]);
+        next = (next + 1) % live_blocks;
+    }
+
+    for (void *block : blocks)
+    {
+        resource.deallocate(block, bytes);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+static void bm_upstream_direct(benchmark::State &state)
+{
+    std::pmr::unsynchronized_pool_resource pool;
+    churn(state, pool);
+}
+
+static void bm_stats_disabled(benchmark::State &state)
+{
+    std::pmr::unsynchronized_pool_resource pool;
+    jc::memory::basic_stats_resource<false> stats(pool);
+    churn(state, stats);
+}
+
+/*
+ * counts and bytes only, state.range(1) sets how often an allocation is timed.
+ */
+static void bm_stats_enabled(benchmark::State &state)
+{
+    std::pmr::unsynchronized_pool_resource pool;
+    jc::memory::basic_stats_resource<true> stats(pool, static_cast<u32>(state.range(1)));
+    churn(state, stats);
+    state.counters["live_bytes"] = static_cast<double>(stats.snapshot().live_bytes());
+}
+
+static void bm_stats_new_delete(benchmark::State &state)
+{
+    jc::memory::basic_stats_resource<true> stats(*std::pmr::new_delete_resource(), 64);
+    churn(state, stats);
+}
+
+static void bm_new_delete_direct(benchmark::State &state)
+{
+    churn(state, *std::pmr::new_delete_resource());
+}
+
+BENCHMARK(bm_upstream_direct)->Arg(32)->Arg(256)->Arg(4096);
+BENCHMARK(bm_stats_disabled)->Arg(32)->Arg(256)->Arg(4096);
+BENCHMARK(bm_stats_enabled)->ArgsProduct({{32, 256, 4096}, {1, 64, 1024}});
+BENCHMARK(bm_new_delete_direct)->Arg(32)->Arg(256)->Arg(4096);
+BENCHMARK(bm_stats_new_delete)->Arg(32)->Arg(256)->Arg(4096);
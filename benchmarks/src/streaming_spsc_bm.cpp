@@ -0,0 +1,204 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/lockfree/spsc.hpp>
+#include <jc_collections/lockfree/thread_pool.hpp>
+#include <jc_collections/memory/stream_copy.hpp>
+#include "../include/cpu_topology.hpp"
+#include "../include/queue_adapters.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*
+ * Large payloads pushed to a consumer thread, e.g. a journaling thread, with and without streaming stores. The
+ * producer has its own 16KB of hot state it walks after every put, standing in for the order book it works on. Per
+ * put the producer reports how long that walk took, which grows as the payload copies evict the hot state, and its
+ * L1D and last level cache read misses when the kernel exposes the PMU (not in most VMs and containers).
+ */
+namespace
+{
+
+constexpr std::size_t ring_size = 256;
+constexpr std::size_t hot_bytes = 16 * 1024;
+
+template <std::size_t bytes>
+using regular_ring = jc::lockfree::cached_spsc<jc::bench::payload<bytes>, ring_size>;
+
+template <std::size_t bytes>
+using streaming_ring =
+    jc::lockfree::basic_spsc<jc::bench::payload<bytes>, ring_size, jc::lockfree::spsc_policy::cached_indexes,
+                             jc::lockfree::spsc_policy::padding::cache_line, jc::lockfree::spsc_policy::spin_wait,
+                             jc::lockfree::spsc_policy::streaming_transfer<1024>>;
+
+/*
+ * counts one cache event for the calling thread only, reads 0 and reports invalid when the PMU isn't available.
+ */
+class cache_miss_counter
+{
+private:
+    int fd_ = -1;
+
+public:
+    explicit cache_miss_counter(const u64 cache)
+    {
+        perf_event_attr attr{};
+        attr.size           = sizeof(attr);
+        attr.type           = PERF_TYPE_HW_CACHE;
+        attr.config         = cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        fd_                 = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    cache_miss_counter(const cache_miss_counter &)            = delete;
+    cache_miss_counter &operator=(const cache_miss_counter &) = delete;
+    cache_miss_counter(cache_miss_counter &&)                 = delete;
+    cache_miss_counter &operator=(cache_miss_counter &&)      = delete;
+
+    ~cache_miss_counter()
+    {
+        if (fd_ >= 0)
+        {
+            close(fd_);
+        }
+    }
+
+    [[nodiscard]] bool valid() const noexcept
+    {
+        return fd_ >= 0;
+    }
+
+    void start() noexcept
+    {
+        if (fd_ >= 0)
+        {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    u64 stop() noexcept
+    {
+        u64 count = 0;
+        if (fd_ >= 0)
+        {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_, &count, sizeof(count)) != sizeof(count))
+            {
+                count = 0;
+            }
+        }
+        return count;
+    }
+};
+
+struct hot_state
+{
+    alignas(64) u64 words_[hot_bytes / sizeof(u64)];
+};
+
+u64 walk(const hot_state &hot) noexcept
+{
+    u64 sum = 0;
+    for (std::size_t i = 0; i < hot_bytes / sizeof(u64); i += 64 / sizeof(u64))
+    {
+        sum += hot.words_[i];
+    }
+    return sum;
+}
+
+/*
+ * the producer puts `batch` payloads per iteration, one at a time or through put_bulk, then walks its hot state.
+ */
+template <typename Queue, std::size_t bytes, std::size_t batch>
+void bm_producer_cache(benchmark::State &state)
+{
+    using value_type = jc::bench::payload<bytes>;
+    static Queue queue;
+    jc::lockfree::pin_current_thread(jc::bench::pair_cpu(state.thread_index()));
+
+    if (state.thread_index() == 0)
+    {
+        static hot_state hot{};
+        std::array<value_type, batch> values{};
+        cache_miss_counter l1d(PERF_COUNT_HW_CACHE_L1D);
+        cache_miss_counter llc(PERF_COUNT_HW_CACHE_LL);
+        i64 walk_ns = 0;
+        u64 sum     = 0;
+
+        l1d.start();
+        llc.start();
+        for (auto _ : state)
+        {
+            if constexpr (batch == 1)
+            {
+                values[0].words_[0]++;
+                queue.put(values[0]);
+            }
+            else
+            {
+                for (value_type &value : values)
+                {
+                    value.words_[0]++;
+                }
+                queue.put_bulk(values);
+            }
+            const auto start = std::chrono::steady_clock::now();
+            sum += walk(hot);
+            walk_ns += std::chrono::nanoseconds(std::chrono::steady_clock::now() - start).count();
+        }
+        const u64 l1d_misses = l1d.stop();
+        const u64 llc_misses = llc.stop();
+        benchmark::DoNotOptimize(sum);
+
+        const auto puts                 = static_cast<double>(state.iterations() * static_cast<i64>(batch));
+        state.counters["hot_walk_ns"]   = static_cast<double>(walk_ns) / static_cast<double>(state.iterations());
+        state.counters["pmu_available"] = l1d.valid() ? 1 : 0;
+        if (l1d.valid())
+        {
+            state.counters["l1d_misses_per_put"] = static_cast<double>(l1d_misses) / puts;
+        }
+        if (llc.valid())
+        {
+            state.counters["llc_misses_per_put"] = static_cast<double>(llc_misses) / puts;
+        }
+    }
+    else
+    {
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < batch; i++)
+            {
+                value_type value = queue.read();
+                benchmark::DoNotOptimize(value);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<i64>(batch));
+    state.SetBytesProcessed(state.iterations() * static_cast<i64>(batch * bytes));
+}
+
+[[maybe_unused]] const bool context = [] {
+    benchmark::AddCustomContext("stream_copy_isa", jc::memory::stream_copy_isa());
+    return true;
+}();
+
+} // namespace
+
+#define JC_STREAMING_BENCHMARKS(bytes, batch)                                                                          \
+    BENCHMARK_TEMPLATE(bm_producer_cache, regular_ring<bytes>, bytes, batch)->Threads(2)->UseRealTime();               \
+    BENCHMARK_TEMPLATE(bm_producer_cache, streaming_ring<bytes>, bytes, batch)->Threads(2)->UseRealTime()
+
+// 512B is under the threshold, both rings copy the same way there
+JC_STREAMING_BENCHMARKS(512, 1);
+JC_STREAMING_BENCHMARKS(1024, 1);
+JC_STREAMING_BENCHMARKS(4096, 1);
+JC_STREAMING_BENCHMARKS(1024, 16);
+JC_STREAMING_BENCHMARKS(4096, 16);
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/lockfree/thread_pool.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using pool_type = jc::lockfree::thread_pool<>;
+
+// below this fib runs serially, splitting further only measures the scheduler
+constexpr int fib_cutoff = 20;
+
+long long fib_serial(const int n)
+{
+    return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+long long fib(pool_type &pool, const int n)
+{
+    if (n < fib_cutoff)
+    {
+        return fib_serial(n);
+    }
+    long long a = 0;
+    long long b = 0;
+    pool.join([&] { a = fib(pool, n - 1); }, [&] { b = fib(pool, n - 2); });
+    return a + b;
+}
+
+std::vector<int> pinned_cores(const std::size_t workers)
+{
+    // the driving thread stays unpinned, workers take cores 0..n-1
+    std::vector<int> cores(workers);
+    std::iota(cores.begin(), cores.end(), 0);
+    return cores;
+}
+
+/*
+ * total participating threads from 1 (driver only) to every core.
+ */
+void worker_counts(benchmark::internal::Benchmark *bm)
+{
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads < cores; threads *= 2)
+    {
+        bm->Arg(threads - 1);
+    }
+    bm->Arg(cores - 1);
+}
+
+} // namespace
+
+static void bm_pool_fib(benchmark::State &state)
+{
+    const auto workers = static_cast<std::size_t>(state.range(0));
+    const auto cores   = pinned_cores(workers);
+    pool_type pool(workers, cores);
+
+    for (auto _ : state)
+    {
+        long long result = 0;
+        pool.run([&] { result = fib(pool, 35); });
+        benchmark::DoNotOptimize(result);
+    }
+    state.counters["threads"] = static_cast<double>(workers + 1);
+}
+
+static void bm_pool_parallel_reduce(benchmark::State &state)
+{
+    static const std::vector<double> values = [] {
+        std::vector<double> result(1 << 26);
+        std::iota(result.begin(), result.end(), 0.0);
+        return result;
+    }();
+
+    const auto workers = static_cast<std::size_t>(state.range(0));
+    const auto cores   = pinned_cores(workers);
+    pool_type pool(workers, cores);
+
+    for (auto _ : state)
+    {
+        double sum = 0;
+        pool.run([&] {
+            sum = pool.parallel_reduce(
+                0, values.size(), 1 << 14, 0.0, [&](const std::size_t i) { return values[i]; },
+                [](const double a, const double b) { return a + b; });
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+    state.counters["threads"] = static_cast<double>(workers + 1);
+}
+
+BENCHMARK(bm_pool_fib)->Apply(worker_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_pool_parallel_reduce)->Apply(worker_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/collections/timer_wheel.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t max_live_timers = 10'500'000;
+// deadlines are spread over this many ticks, roughly a minute at 1ms resolution
+constexpr u64 deadline_spread = 60'000;
+
+using wheel_type = jc::collections::timer_wheel<max_live_timers>;
+
+std::unique_ptr<wheel_type> make_wheel(const std::size_t live, std::mt19937_64 &rng)
+{
+    auto wheel = std::make_unique<wheel_type>(*std::pmr::get_default_resource());
+    for (std::size_t i = 0; i < live; i++)
+    {
+        (void)wheel->schedule(1 + (rng() % deadline_spread), i);
+    }
+    return wheel;
+}
+
+} // namespace
+
+static void bm_timer_wheel_schedule_cancel(benchmark::State &state)
+{
+    std::mt19937_64 rng(42);
+    const auto wheel = make_wheel(static_cast<std::size_t>(state.range(0)), rng);
+
+    for (auto _ : state)
+    {
+        jc::collections::timer_node *node = wheel->schedule(1 + (rng() % deadline_spread), 0);
+        benchmark::DoNotOptimize(node);
+        wheel->cancel(node);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/*
+ * every tick fires its due timers and re-arms them, keeping the number of live timers constant.
+ */
+static void bm_timer_wheel_expire(benchmark::State &state)
+{
+    std::mt19937_64 rng(42);
+    const auto wheel = make_wheel(static_cast<std::size_t>(state.range(0)), rng);
+
+    std::vector<u64> rearm;
+    std::size_t fired = 0;
+    for (auto _ : state)
+    {
+        fired += wheel->advance(wheel->now() + 1, [&](u64, const u64 user_data) { rearm.push_back(user_data); });
+        for (const u64 user_data : rearm)
+        {
+            (void)wheel->schedule(wheel->now() + 1 + (rng() % deadline_spread), user_data);
+        }
+        rearm.clear();
+    }
+    state.SetItemsProcessed(static_cast<i64>(fired));
+}
+
+static void bm_priority_queue_schedule_pop(benchmark::State &state)
+{
+    using entry = std::pair<u64, u64>;
+    std::mt19937_64 rng(42);
+    std::mutex mutex;
+    std::priority_queue<entry, std::vector<entry>, std::greater<>> timers;
+    for (i64 i = 0; i < state.range(0); i++)
+    {
+        timers.emplace(1 + (rng() % deadline_spread), static_cast<u64>(i));
+    }
+
+    u64 now = 0;
+    for (auto _ : state)
+    {
+        std::lock_guard lock(mutex);
+        const entry next = timers.top();
+        timers.pop();
+        now = next.first;
+        timers.emplace(now + 1 + (rng() % deadline_spread), next.second);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bm_timer_wheel_schedule_cancel)->Arg(1'000'000)->Arg(5'000'000)->Arg(10'000'000);
+BENCHMARK(bm_timer_wheel_expire)->Arg(1'000'000)->Arg(5'000'000)->Arg(10'000'000);
+BENCHMARK(bm_priority_queue_schedule_pop)->Arg(1'000'000)->Arg(5'000'000)->Arg(10'000'000);
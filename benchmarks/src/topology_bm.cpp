@@ -0,0 +1,153 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/lockfree/thread_pool.hpp>
+#include "../include/cpu_topology.hpp"
+#include "../include/queue_adapters.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/*
+ * Every queue across every producer/consumer placement this box offers: SMT siblings, two cores behind one L3, two
+ * L3 domains (CCX/CCD) on one node, and two NUMA nodes. Pairings the machine doesn't have are skipped.
+ *
+ * Run with --benchmark_out=topology.json --benchmark_out_format=json, or --benchmark_filter=topology/ to get only
+ * this matrix. Each entry is named topology/<workload>/<queue>/<pairing>/<bytes>B/<capacity> and carries the same
+ * fields as counters and label, and the context records the topology that was read.
+ */
+namespace
+{
+
+struct placement
+{
+    int producer_cpu_;
+    int consumer_cpu_;
+};
+
+template <typename Queue>
+void throughput(benchmark::State &state, const placement cpus)
+{
+    static Queue queue;
+    using value_type = decltype(queue.pop());
+    jc::lockfree::pin_current_thread(state.thread_index() == 0 ? cpus.producer_cpu_ : cpus.consumer_cpu_);
+    if (state.thread_index() == 0)
+    {
+        value_type value{};
+        for (auto _ : state)
+        {
+            value.words_[0]++;
+            queue.push(value);
+        }
+    }
+    else
+    {
+        for (auto _ : state)
+        {
+            value_type value = queue.pop();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<i64>(sizeof(value_type)));
+}
+
+/*
+ * ping-pong through a pair of queues, each iteration is one round trip.
+ */
+template <typename Queue>
+void round_trip(benchmark::State &state, const placement cpus)
+{
+    static Queue there;
+    static Queue back;
+    using value_type = decltype(there.pop());
+    jc::lockfree::pin_current_thread(state.thread_index() == 0 ? cpus.producer_cpu_ : cpus.consumer_cpu_);
+    if (state.thread_index() == 0)
+    {
+        value_type value{};
+        for (auto _ : state)
+        {
+            there.push(value);
+            value = back.pop();
+        }
+        benchmark::DoNotOptimize(value);
+    }
+    else
+    {
+        for (auto _ : state)
+        {
+            value_type value = there.pop();
+            back.push(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <template <typename, std::size_t> typename Queue, std::size_t bytes, std::size_t capacity>
+void register_one(const jc::bench::pairing kind, const placement cpus)
+{
+    using queue_type          = Queue<jc::bench::payload<bytes>, capacity>;
+    const std::string pairing = std::string(jc::bench::pairing_name(kind));
+    const std::string suffix  = std::string(queue_type::name) + "/" + pairing + "/" + std::to_string(bytes) + "B/" +
+                               std::to_string(capacity);
+    const std::string label   = "queue=" + std::string(queue_type::name) + ",pairing=" + pairing;
+    const auto annotate       = [=](benchmark::State &state) {
+        // both threads report the same values, averaging keeps them from being summed
+        constexpr auto per_thread = benchmark::Counter::kAvgThreads;
+        state.SetLabel(label);
+        state.counters["element_bytes"] = benchmark::Counter(static_cast<double>(bytes), per_thread);
+        state.counters["capacity"]      = benchmark::Counter(static_cast<double>(capacity), per_thread);
+        state.counters["producer_cpu"]  = benchmark::Counter(cpus.producer_cpu_, per_thread);
+        state.counters["consumer_cpu"]  = benchmark::Counter(cpus.consumer_cpu_, per_thread);
+    };
+
+    benchmark::RegisterBenchmark(("topology/throughput/" + suffix).c_str(),
+                                 [=](benchmark::State &state) {
+                                     throughput<queue_type>(state, cpus);
+                                     annotate(state);
+                                 })
+        ->Threads(2)
+        ->UseRealTime();
+    benchmark::RegisterBenchmark(("topology/round_trip/" + suffix).c_str(),
+                                 [=](benchmark::State &state) {
+                                     round_trip<queue_type>(state, cpus);
+                                     annotate(state);
+                                 })
+        ->Threads(2)
+        ->UseRealTime();
+}
+
+template <template <typename, std::size_t> typename Queue>
+void register_queue(const jc::bench::pairing kind, const placement cpus)
+{
+    register_one<Queue, 8, 512>(kind, cpus);
+    register_one<Queue, 8, 8192>(kind, cpus);
+    register_one<Queue, 64, 512>(kind, cpus);
+    register_one<Queue, 64, 8192>(kind, cpus);
+}
+
+bool register_matrix()
+{
+    const jc::bench::cpu_topology topology;
+    benchmark::AddCustomContext("cpu_topology", topology.describe());
+    for (const jc::bench::pairing kind : jc::bench::all_pairings)
+    {
+        const auto pair = topology.find_pair(kind);
+        if (!pair)
+        {
+            continue;
+        }
+        const placement cpus{pair->first, pair->second};
+        benchmark::AddCustomContext("pairing_" + std::string(jc::bench::pairing_name(kind)),
+                                    std::to_string(cpus.producer_cpu_) + "," + std::to_string(cpus.consumer_cpu_));
+        register_queue<jc::bench::jc_simple>(kind, cpus);
+        register_queue<jc::bench::jc_cached>(kind, cpus);
+        register_queue<jc::bench::jc_unbounded>(kind, cpus);
+        register_queue<jc::bench::rigtorp_queue>(kind, cpus);
+        register_queue<jc::bench::boost_queue>(kind, cpus);
+    }
+    return true;
+}
+
+[[maybe_unused]] const bool registered = register_matrix();
+
+} // namespace
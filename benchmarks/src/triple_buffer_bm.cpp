@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/lockfree/spsc.hpp>
+#include <jc_collections/lockfree/triple_buffer.hpp>
+
+#include <atomic>
+
+namespace
+{
+
+struct quote
+{
+    long long sequence_;
+    double bid_;
+    double ask_;
+};
+
+// the newest sequence number the producer has produced, used to measure how far behind the consumer is
+std::atomic<long long> published{0};
+
+void record_lag(benchmark::State &state, const double total_lag, const long long reads)
+{
+    state.counters["mean_lag"] = reads > 0 ? total_lag / static_cast<double>(reads) : 0.0;
+    state.counters["reads"]    = static_cast<double>(reads);
+}
+
+} // namespace
+
+static void bm_triple_buffer_latest(benchmark::State &state)
+{
+    static jc::lockfree::triple_buffer<quote> mailbox;
+
+    if (state.thread_index() == 0)
+    {
+        long long seq = 0;
+        for (auto _ : state)
+        {
+            published.store(++seq, std::memory_order::relaxed);
+            mailbox.put(quote{seq, 1.0, 1.5});
+        }
+    }
+    else
+    {
+        double total_lag = 0;
+        long long reads  = 0;
+        for (auto _ : state)
+        {
+            if (mailbox.update())
+            {
+                total_lag += static_cast<double>(published.load(std::memory_order::relaxed) -
+                                                 mailbox.front().sequence_);
+                ++reads;
+            }
+        }
+        record_lag(state, total_lag, reads);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/*
+ * the consumer drains the queue down to its last element each time, which is what consumers that only want the
+ * newest value do with cached_spsc today.
+ */
+static void bm_spsc_drain_to_latest(benchmark::State &state)
+{
+    static jc::lockfree::cached_spsc<quote, 512> q;
+
+    if (state.thread_index() == 0)
+    {
+        // a blocking put could leave the producer stuck once the consumer stops, so count full rings as drops
+        long long seq     = 0;
+        long long dropped = 0;
+        for (auto _ : state)
+        {
+            // a dropped update still counts as published, the consumer is now behind it
+            published.store(++seq, std::memory_order::relaxed);
+            if (!q.try_put(quote{seq, 1.0, 1.5}))
+            {
+                ++dropped;
+            }
+        }
+        state.counters["dropped"] = static_cast<double>(dropped);
+    }
+    else
+    {
+        double total_lag = 0;
+        long long reads  = 0;
+        for (auto _ : state)
+        {
+            std::optional<quote> latest;
+            while (auto next = q.try_read())
+            {
+                latest = next;
+            }
+            if (latest)
+            {
+                total_lag += static_cast<double>(published.load(std::memory_order::relaxed) - latest->sequence_);
+                ++reads;
+            }
+        }
+        record_lag(state, total_lag, reads);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void bm_conflating_queue(benchmark::State &state)
+{
+    static constexpr std::size_t keys = 64;
+    static jc::lockfree::conflating_queue<quote, keys> q;
+
+    if (state.thread_index() == 0)
+    {
+        long long seq = 0;
+        for (auto _ : state)
+        {
+            published.store(++seq, std::memory_order::relaxed);
+            q.put(static_cast<std::size_t>(seq) & (keys - 1), quote{seq, 1.0, 1.5});
+        }
+    }
+    else
+    {
+        double total_lag = 0;
+        long long reads  = 0;
+        for (auto _ : state)
+        {
+            std::size_t key;
+            quote value;
+            if (q.try_read(key, value))
+            {
+                total_lag += static_cast<double>(published.load(std::memory_order::relaxed) - value.sequence_);
+                ++reads;
+            }
+        }
+        record_lag(state, total_lag, reads);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bm_triple_buffer_latest)->Threads(2)->UseRealTime()->MinTime(1.0);
+BENCHMARK(bm_spsc_drain_to_latest)->Threads(2)->UseRealTime()->MinTime(1.0);
+BENCHMARK(bm_conflating_queue)->Threads(2)->UseRealTime()->MinTime(1.0);
@@ -0,0 +1,174 @@
+#include <benchmark/benchmark.h>
+#include <jc_collections/lockfree/spsc.hpp>
+#include <jc_collections/lockfree/unbounded_spsc.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+namespace
+{
+
+struct tick
+{
+    u64 instrument_;
+    u64 price_;
+    u64 quantity_;
+    i64 timestamp_ns_;
+};
+
+constexpr std::size_t ring_size = 1 << 12;
+
+/*
+ * steady state: producer and consumer on their own threads, the unbounded queue recycles the same few segments.
+ */
+void bm_cached_spsc_throughput(benchmark::State &state)
+{
+    static jc::lockfree::cached_spsc<tick, ring_size> queue;
+    if (state.thread_index() == 0)
+    {
+        u64 i = 0;
+        for (auto _ : state)
+        {
+            queue.put(tick{i, i, i, 0});
+            ++i;
+        }
+    }
+    else
+    {
+        for (auto _ : state)
+        {
+            tick value = queue.read();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void bm_unbounded_spsc_throughput(benchmark::State &state)
+{
+    static jc::lockfree::unbounded_spsc<tick, ring_size> queue;
+    if (state.thread_index() == 0)
+    {
+        u64 i = 0;
+        for (auto _ : state)
+        {
+            queue.put(tick{i, i, i, 0});
+            ++i;
+        }
+    }
+    else
+    {
+        for (auto _ : state)
+        {
+            tick value = queue.read();
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0)
+    {
+        state.counters["segments"] = static_cast<double>(queue.segments());
+    }
+}
+
+/*
+ * single thread put/read pairs, the per element cost without any cross core traffic.
+ */
+template <typename Queue>
+void bm_round_trip(benchmark::State &state)
+{
+    auto queue = std::make_unique<Queue>();
+    u64 i      = 0;
+    for (auto _ : state)
+    {
+        queue->put(tick{i, i, i, 0});
+        tick value = queue->read();
+        benchmark::DoNotOptimize(value);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+constexpr u64 burst_messages = 1 << 20;
+constexpr auto stall         = std::chrono::milliseconds(100);
+
+/*
+ * the consumer stops for 100ms while the producer publishes a burst of market data it must not block on. The
+ * bounded ring drops what doesn't fit, the unbounded queue grows and then drains. Reported per burst: drops, the
+ * producer's worst single publish, and for the unbounded queue the memory it grew to.
+ */
+template <typename Queue, bool bounded>
+void bm_consumer_stall(benchmark::State &state)
+{
+    auto queue    = std::make_unique<Queue>();
+    u64 drops     = 0;
+    i64 worst_put = 0;
+    for (auto _ : state)
+    {
+        std::atomic<bool> done = false;
+        std::thread consumer([&] {
+            std::this_thread::sleep_for(stall);
+            u64 received = 0;
+            while (true)
+            {
+                const bool finished = done.load(std::memory_order::acquire);
+                if (auto value = queue->try_read())
+                {
+                    benchmark::DoNotOptimize(*value);
+                    ++received;
+                    continue;
+                }
+                if (finished)
+                {
+                    break;
+                }
+            }
+            benchmark::DoNotOptimize(received);
+        });
+
+        for (u64 i = 0; i < burst_messages; i++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            bool accepted    = false;
+            if constexpr (bounded)
+            {
+                accepted = queue->try_put(tick{i, i, i, 0});
+            }
+            else
+            {
+                accepted = queue->put(tick{i, i, i, 0});
+            }
+            const i64 took = std::chrono::nanoseconds(std::chrono::steady_clock::now() - start).count();
+            worst_put      = std::max(worst_put, took);
+            drops += accepted ? 0 : 1;
+        }
+        done.store(true, std::memory_order::release);
+        consumer.join();
+    }
+    state.counters["drops_per_burst"] =
+        benchmark::Counter(static_cast<double>(drops), benchmark::Counter::kAvgIterations);
+    state.counters["worst_put_ns"] = static_cast<double>(worst_put);
+    if constexpr (!bounded)
+    {
+        state.counters["peak_mb"] =
+            static_cast<double>(queue->segments() * Queue::segment_bytes) / static_cast<double>(1 << 20);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<i64>(burst_messages));
+}
+
+} // namespace
+
+BENCHMARK(bm_cached_spsc_throughput)->Threads(2)->UseRealTime();
+BENCHMARK(bm_unbounded_spsc_throughput)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(bm_round_trip, jc::lockfree::cached_spsc<tick, ring_size>);
+BENCHMARK_TEMPLATE(bm_round_trip, jc::lockfree::unbounded_spsc<tick, ring_size>);
+BENCHMARK_TEMPLATE(bm_consumer_stall, jc::lockfree::cached_spsc<tick, ring_size>, true)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bm_consumer_stall, jc::lockfree::unbounded_spsc<tick, ring_size>, false)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
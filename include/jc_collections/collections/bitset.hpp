@@ -30,9 +30,14 @@ public:
 
         // index of the bit to be set
         const i64 i = std::countr_one(bits[idx]);
+        // the last word may have bits past capacity
+        if ((64 * idx) + i >= static_cast<i64>(capacity)) [[unlikely]]
+        {
+            return -1;
+        }
 
         // toggle the bit
-        bits[idx] |= (1 << i);
+        bits[idx] |= (u64{1} << i);
 
         return (64 * idx) + i;
     }
@@ -45,7 +50,7 @@ public:
         }
         const size_t arr_index = pos >> 6;
         const size_t remainder = pos & 63;
-        const size_t mask      = 1 << remainder;
+        const u64 mask         = u64{1} << remainder;
 
         bits[arr_index] &= ~mask;
     }
@@ -59,11 +64,57 @@ public:
 
         const size_t arr_index = pos >> 6;
         const size_t remainder = pos & 63;
-        const size_t mask      = 1 << remainder;
+        const u64 mask         = u64{1} << remainder;
 
         bits[arr_index] |= mask;
     }
 
+    [[nodiscard]] bool test(const size_t pos) const noexcept
+    {
+        if (pos >= capacity)
+        {
+            return false;
+        }
+        return (bits[pos >> 6] >> (pos & 63)) & 1;
+    }
+
+    /*
+     * index of the first set bit at or after pos, -1 if there is none.
+     */
+    [[nodiscard]] i64 find_next_set(const size_t pos) const noexcept
+    {
+        if (pos >= capacity)
+        {
+            return -1;
+        }
+
+        size_t idx = pos >> 6;
+        u64 word   = bits[idx] & (max_val << (pos & 63));
+        while (word == 0)
+        {
+            if (++idx >= arr_len())
+            {
+                return -1;
+            }
+            word = bits[idx];
+        }
+
+        const size_t found = (idx << 6) + static_cast<size_t>(std::countr_zero(word));
+        return found < capacity ? static_cast<i64>(found) : -1;
+    }
+
+    [[nodiscard]] bool none() const noexcept
+    {
+        for (size_t idx = 0; idx < arr_len(); idx++)
+        {
+            if (bits[idx] != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
 private:
     static constexpr u64 max_val = static_cast<u64>(-1);
     static constexpr size_t arr_len()
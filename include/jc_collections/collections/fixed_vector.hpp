@@ -0,0 +1,379 @@
+#ifndef JC_FIXED_VECTOR_H
+#define JC_FIXED_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <type_traits>
+
+#include <jc_collections/memory/fixed_arena.hpp>
+
+namespace jc::collections
+{
+
+/**
+ * @brief A vector living in a `jc::memory::fixed_arena`, usable in constant expressions.
+ *
+ * The elements are the arena's allocated prefix, pushing bumps it by one. It never grows past `capacity`: push_back
+ * returns false once the arena is full, and reserve only reports whether the capacity is enough.
+ *
+ * Built in a constexpr initializer it is a literal, so a table computed by a constexpr function is emitted straight
+ * into `.rodata` and costs nothing at startup. `arena_vector` has the same interface at runtime.
+ */
+template <typename T, std::size_t capacity_>
+class fixed_vector
+{
+public:
+    constexpr fixed_vector() noexcept = default;
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept
+    {
+        return arena_.used();
+    }
+
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept
+    {
+        return capacity_;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return arena_.used() == 0;
+    }
+
+    constexpr void clear() noexcept
+    {
+        arena_.reset();
+    }
+
+    [[nodiscard]] constexpr bool reserve(const std::size_t n) const noexcept
+    {
+        return n <= capacity_;
+    }
+
+    constexpr bool push_back(const T &value) noexcept(std::is_nothrow_copy_assignable_v<T>)
+    {
+        T *slot = arena_.allocate(1);
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        *slot = value;
+        return true;
+    }
+
+    /**
+     * @brief Grows with value initialized elements or drops elements from the back.
+     */
+    constexpr bool resize(const std::size_t n) noexcept
+    {
+        const std::size_t size = arena_.used();
+        if (n < size)
+        {
+            arena_.deallocate(data() + n, size - n);
+            return true;
+        }
+        T *fresh = arena_.allocate(n - size);
+        if (fresh == nullptr)
+        {
+            return false;
+        }
+        std::fill(fresh, fresh + (n - size), T{});
+        return true;
+    }
+
+    /**
+     * @brief Inserts `value` before position `idx`, shifting the rest back by one.
+     */
+    constexpr bool insert(const std::size_t idx, const T &value) noexcept
+    {
+        if (arena_.allocate(1) == nullptr)
+        {
+            return false;
+        }
+        std::copy_backward(data() + idx, end() - 1, end());
+        data()[idx] = value;
+        return true;
+    }
+
+    constexpr void erase(const std::size_t idx) noexcept
+    {
+        std::copy(data() + idx + 1, end(), data() + idx);
+        arena_.deallocate(end() - 1, 1);
+    }
+
+    [[nodiscard]] constexpr T *data() noexcept
+    {
+        return arena_.data();
+    }
+
+    [[nodiscard]] constexpr const T *data() const noexcept
+    {
+        return arena_.data();
+    }
+
+    [[nodiscard]] constexpr T &operator[](const std::size_t idx) noexcept
+    {
+        return data()[idx];
+    }
+
+    [[nodiscard]] constexpr const T &operator[](const std::size_t idx) const noexcept
+    {
+        return data()[idx];
+    }
+
+    [[nodiscard]] constexpr T *begin() noexcept
+    {
+        return data();
+    }
+
+    [[nodiscard]] constexpr T *end() noexcept
+    {
+        return data() + size();
+    }
+
+    [[nodiscard]] constexpr const T *begin() const noexcept
+    {
+        return data();
+    }
+
+    [[nodiscard]] constexpr const T *end() const noexcept
+    {
+        return data() + size();
+    }
+
+private:
+    memory::fixed_arena<T, capacity_> arena_;
+};
+
+/**
+ * @brief The runtime counterpart of `fixed_vector`: same interface, storage pulled from a
+ * `std::pmr::memory_resource`, typically a `jc::memory::base_allocator`.
+ *
+ * Since an arena does not reclaim memory on deallocate, callers should `reserve()` the expected size up front so the
+ * elements are one bump. Elements are required to be trivially copyable so that growth is a plain memcpy.
+ *
+ * Like the rest of the library nothing here throws: operations that may allocate return false on failure and leave
+ * the container unchanged.
+ *
+ * Note: This implementation is NOT thread-safe.
+ */
+template <typename T>
+    requires std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>
+class arena_vector
+{
+public:
+    explicit arena_vector(std::pmr::memory_resource &resource) noexcept : resource_(&resource)
+    {
+    }
+
+    ~arena_vector() noexcept
+    {
+        release();
+    }
+
+    // the buffer is owned by this object, copying would lead to a double free
+    arena_vector(const arena_vector &)            = delete;
+    arena_vector &operator=(const arena_vector &) = delete;
+
+    arena_vector(arena_vector &&other) noexcept
+        : resource_(other.resource_), data_(other.data_), size_(other.size_), capacity_(other.capacity_)
+    {
+        other.data_     = nullptr;
+        other.size_     = 0;
+        other.capacity_ = 0;
+    }
+
+    arena_vector &operator=(arena_vector &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            resource_       = other.resource_;
+            data_           = other.data_;
+            size_           = other.size_;
+            capacity_       = other.capacity_;
+            other.data_     = nullptr;
+            other.size_     = 0;
+            other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    void clear() noexcept
+    {
+        size_ = 0;
+    }
+
+    /**
+     * @brief Ensures space for at least `n` elements.
+     * @return false if the resource could not provide the memory, the vector is left untouched.
+     */
+    bool reserve(const std::size_t n) noexcept
+    {
+        if (n <= capacity_)
+        {
+            return true;
+        }
+        T *fresh = allocate(n);
+        if (fresh == nullptr)
+        {
+            return false;
+        }
+        if (size_ != 0)
+        {
+            std::memcpy(fresh, data_, size_ * sizeof(T));
+        }
+        release();
+        data_     = fresh;
+        capacity_ = n;
+        return true;
+    }
+
+    /**
+     * @brief Appends a single element, growing geometrically if needed.
+     */
+    bool push_back(const T &value) noexcept
+    {
+        if (!room_for_one())
+        {
+            return false;
+        }
+        data_[size_++] = value;
+        return true;
+    }
+
+    /**
+     * @brief Grows with value initialized elements or drops elements from the back. Growing past the capacity at
+     * least doubles it, so resizing one element at a time doesn't reallocate every time.
+     */
+    bool resize(const std::size_t n) noexcept
+    {
+        if (n > capacity_ && !reserve(std::max(n, capacity_ * 2)) && !reserve(n))
+        {
+            return false;
+        }
+        std::fill(data_ + std::min(size_, n), data_ + n, T{});
+        size_ = n;
+        return true;
+    }
+
+    /**
+     * @brief Inserts `value` before position `idx`, shifting the rest back by one.
+     */
+    bool insert(const std::size_t idx, const T &value) noexcept
+    {
+        if (!room_for_one())
+        {
+            return false;
+        }
+        std::memmove(data_ + idx + 1, data_ + idx, (size_ - idx) * sizeof(T));
+        data_[idx] = value;
+        ++size_;
+        return true;
+    }
+
+    void erase(const std::size_t idx) noexcept
+    {
+        std::memmove(data_ + idx, data_ + idx + 1, (size_ - idx - 1) * sizeof(T));
+        --size_;
+    }
+
+    [[nodiscard]] T *data() noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] const T *data() const noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] T &operator[](const std::size_t idx) noexcept
+    {
+        return data_[idx];
+    }
+
+    [[nodiscard]] const T &operator[](const std::size_t idx) const noexcept
+    {
+        return data_[idx];
+    }
+
+    [[nodiscard]] T *begin() noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] T *end() noexcept
+    {
+        return data_ + size_;
+    }
+
+    [[nodiscard]] const T *begin() const noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] const T *end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+private:
+    // a cache line's worth so tiny vectors don't reallocate repeatedly
+    static constexpr std::size_t min_capacity = std::max(std::size_t{1}, 64 / sizeof(T));
+
+    bool room_for_one() noexcept
+    {
+        return size_ < capacity_ || reserve(std::max({size_ + 1, capacity_ * 2, min_capacity}));
+    }
+
+    T *allocate(const std::size_t n) noexcept
+    {
+        // pmr resources report failure by throwing, base_allocator reports it by returning nullptr
+        try
+        {
+            return static_cast<T *>(resource_->allocate(n * sizeof(T), alignof(T)));
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    void release() noexcept
+    {
+        if (capacity_ == 0)
+        {
+            return;
+        }
+        resource_->deallocate(data_, capacity_ * sizeof(T), alignof(T));
+        data_     = nullptr;
+        capacity_ = 0;
+    }
+
+    std::pmr::memory_resource *resource_;
+    T *data_              = nullptr;
+    std::size_t size_     = 0;
+    std::size_t capacity_ = 0;
+};
+
+} // namespace jc::collections
+
+#endif
@@ -0,0 +1,584 @@
+#ifndef JC_FLAT_MAP_H
+#define JC_FLAT_MAP_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include <jc_collections/collections/fixed_vector.hpp>
+#include <jc_collections/util.h>
+
+namespace jc::collections
+{
+
+namespace flat_layout
+{
+/*
+ * how a flat_set/flat_map searches its keys. The sorted keys are always kept as they are, for iteration and to line
+ * up with the values. A layout can add a second copy of the keys arranged for searching: that costs memory and a
+ * rebuild on every insert/erase, but a cold find then touches far fewer cache lines.
+ *
+ * Every layout has a nested `index<K>` built from the sorted keys and answering lower_bound with a position in them.
+ */
+
+/*
+ * branchless binary search over the sorted keys themselves, no extra memory. Both candidates for the next probe are
+ * prefetched, still every halving past the cache sizes waits on memory.
+ */
+struct sorted
+{
+    template <typename K>
+    class index
+    {
+    public:
+        explicit index(std::pmr::memory_resource &) noexcept
+        {
+        }
+
+        bool build(std::span<const K>) noexcept
+        {
+            return true;
+        }
+
+        [[nodiscard]] std::size_t lower_bound(const std::span<const K> keys, const K &key) const noexcept
+        {
+            if (keys.empty())
+            {
+                return 0;
+            }
+            const K *base   = keys.data();
+            std::size_t len = keys.size();
+            while (len > 1)
+            {
+                const std::size_t half = len / 2;
+                const std::size_t next = (len - half) / 2;
+                __builtin_prefetch(base + next);
+                __builtin_prefetch(base + half + next);
+                base += base[half - 1] < key ? half : 0;
+                len -= half;
+            }
+            return static_cast<std::size_t>(base - keys.data()) + (*base < key ? 1 : 0);
+        }
+    };
+};
+
+/*
+ * the keys in breadth first order, k's children at 2k and 2k + 1. The top levels share a few hot cache lines, and the
+ * descent is branchless with the line holding the 16 (4 byte keys) or 8 (8 byte keys) nodes four or three levels down
+ * prefetched at every step. Costs a copy of the keys and a u32 position per key.
+ */
+struct eytzinger
+{
+    template <typename K>
+    class index
+    {
+    public:
+        explicit index(std::pmr::memory_resource &resource) noexcept : keys_(resource), ranks_(resource)
+        {
+        }
+
+        bool build(const std::span<const K> sorted) noexcept
+        {
+            if (sorted.size() >= std::numeric_limits<u32>::max() || !keys_.resize(sorted.size() + 1) ||
+                !ranks_.resize(sorted.size() + 1))
+            {
+                return false;
+            }
+            std::size_t next = 0;
+            place(sorted, 1, next);
+            ranks_[0] = static_cast<u32>(sorted.size());
+            return true;
+        }
+
+        [[nodiscard]] std::size_t lower_bound(const std::span<const K> keys, const K &key) const noexcept
+        {
+            if (keys.empty())
+            {
+                return 0;
+            }
+            const std::size_t n = keys.size();
+            const K *tree       = keys_.data();
+            std::size_t k       = 1;
+            while (k <= n)
+            {
+                __builtin_prefetch(tree + std::min(k * per_line, n));
+                k = 2 * k + (tree[k] < key ? 1 : 0);
+            }
+            // the right turns after the last left turn lead past the answer, undo them and that left turn
+            k >>= std::countr_one(k) + 1;
+            return ranks_[k];
+        }
+
+    private:
+        static constexpr std::size_t per_line = std::max(std::size_t{1}, 64 / sizeof(K));
+
+        void place(const std::span<const K> sorted, const std::size_t k, std::size_t &next) noexcept
+        {
+            if (k > sorted.size())
+            {
+                return;
+            }
+            place(sorted, 2 * k, next);
+            keys_[k]  = sorted[next];
+            ranks_[k] = static_cast<u32>(next++);
+            place(sorted, 2 * k + 1, next);
+        }
+
+        arena_vector<K> keys_;
+        arena_vector<u32> ranks_;
+    };
+};
+
+/*
+ * a static B-tree: nodes of one cache line of keys, each node's B + 1 children stored implicitly after it. A find
+ * reads one line per level, log_(B+1)(n) lines instead of log_2(n) probes. 32 and 64 bit integer keys are compared a
+ * whole node at a time with SIMD, whichever of AVX-512, AVX2 and SSE the build targets: the search is too short to go
+ * through a runtime dispatched function the way stream_copy does, so build with e.g. -march=native to get the wider
+ * ones. Other keys are compared one by one. Costs a copy of the keys and a u32 position per key.
+ */
+struct btree
+{
+    template <typename K>
+    static constexpr bool simd_key = std::is_integral_v<K> && (sizeof(K) == 4 || sizeof(K) == 8);
+
+    template <typename K, bool simd = simd_key<K>>
+    struct lane_of
+    {
+        using type = K;
+    };
+
+    template <typename K>
+    struct lane_of<K, true>
+    {
+        // unsigned keys are stored with the sign bit flipped so the signed SIMD compares order them correctly
+        using type = std::make_signed_t<K>;
+    };
+
+    template <typename K>
+    class index
+    {
+    public:
+        static constexpr bool simd           = simd_key<K>;
+        static constexpr std::size_t node_sz = std::max(std::size_t{2}, 64 / sizeof(K));
+
+        explicit index(std::pmr::memory_resource &resource) noexcept : nodes_(resource), ranks_(resource)
+        {
+        }
+
+        bool build(const std::span<const K> sorted) noexcept
+        {
+            const std::size_t count = (sorted.size() + node_sz - 1) / node_sz;
+            if (sorted.size() >= std::numeric_limits<u32>::max() || !nodes_.resize(count) ||
+                !ranks_.resize(count * node_sz))
+            {
+                return false;
+            }
+            std::size_t next = 0;
+            place(sorted, 0, next);
+            return true;
+        }
+
+        [[nodiscard]] std::size_t lower_bound(const std::span<const K> keys, const K &key) const noexcept
+        {
+            const lane probe   = to_lane(key);
+            std::size_t result = keys.size();
+            for (std::size_t k = 0; k < nodes_.size();)
+            {
+                const std::size_t i = count_less(nodes_[k], probe);
+                // the first key not less than `key` in this node, anything found further down comes before it
+                if (i < node_sz)
+                {
+                    result = ranks_[k * node_sz + i];
+                }
+                k = child(k, i);
+            }
+            return result;
+        }
+
+    private:
+        using lane = typename lane_of<K>::type;
+
+        struct alignas(64) node
+        {
+            lane keys_[node_sz];
+        };
+
+        static constexpr std::size_t child(const std::size_t k, const std::size_t i) noexcept
+        {
+            return k * (node_sz + 1) + i + 1;
+        }
+
+        static lane to_lane(const K key) noexcept
+        {
+            if constexpr (simd && std::is_unsigned_v<K>)
+            {
+                return static_cast<lane>(key ^ (K{1} << (sizeof(K) * 8 - 1)));
+            }
+            else
+            {
+                return key;
+            }
+        }
+
+        /*
+         * fills the tree in order. Slots past the last key repeat it so every node stays sorted, and point past the
+         * end: a key found there is only ever the first not less than `key` when it is the real one.
+         */
+        void place(const std::span<const K> sorted, const std::size_t k, std::size_t &next) noexcept
+        {
+            if (k >= nodes_.size())
+            {
+                return;
+            }
+            for (std::size_t i = 0; i < node_sz; i++)
+            {
+                place(sorted, child(k, i), next);
+                const bool real         = next < sorted.size();
+                nodes_[k].keys_[i]      = to_lane(real ? sorted[next] : sorted.back());
+                ranks_[k * node_sz + i] = static_cast<u32>(real ? next++ : sorted.size());
+            }
+            place(sorted, child(k, node_sz), next);
+        }
+
+        /* how many keys of a node are less than `probe`, which is where the search goes next */
+        static std::size_t count_less(const node &block, const lane probe) noexcept
+        {
+#if defined(__AVX512F__)
+            if constexpr (simd && sizeof(K) == 4)
+            {
+                const __m512i keys = _mm512_load_si512(block.keys_);
+                return std::popcount(static_cast<u32>(_mm512_cmpgt_epi32_mask(_mm512_set1_epi32(probe), keys)));
+            }
+            if constexpr (simd && sizeof(K) == 8)
+            {
+                const __m512i keys = _mm512_load_si512(block.keys_);
+                return std::popcount(static_cast<u32>(_mm512_cmpgt_epi64_mask(_mm512_set1_epi64(probe), keys)));
+            }
+#elif defined(__AVX2__)
+            if constexpr (simd && sizeof(K) == 4)
+            {
+                const auto *halves = reinterpret_cast<const __m256i *>(block.keys_);
+                const __m256i x    = _mm256_set1_epi32(probe);
+                const int low      = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, halves[0])));
+                const int high     = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, halves[1])));
+                return std::popcount(static_cast<u32>(low | high << 8));
+            }
+            if constexpr (simd && sizeof(K) == 8)
+            {
+                const auto *halves = reinterpret_cast<const __m256i *>(block.keys_);
+                const __m256i x    = _mm256_set1_epi64x(probe);
+                const int low      = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(x, halves[0])));
+                const int high     = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(x, halves[1])));
+                return std::popcount(static_cast<u32>(low | high << 4));
+            }
+#elif defined(__SSE2__)
+            if constexpr (simd && sizeof(K) == 4)
+            {
+                const auto *quarters = reinterpret_cast<const __m128i *>(block.keys_);
+                const __m128i x      = _mm_set1_epi32(probe);
+                u32 mask             = 0;
+                for (std::size_t q = 0; q < 4; q++)
+                {
+                    const __m128i less = _mm_cmpgt_epi32(x, quarters[q]);
+                    mask |= static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(less))) << (4 * q);
+                }
+                return std::popcount(mask);
+            }
+#if defined(__SSE4_2__)
+            if constexpr (simd && sizeof(K) == 8)
+            {
+                const auto *quarters = reinterpret_cast<const __m128i *>(block.keys_);
+                const __m128i x      = _mm_set1_epi64x(probe);
+                u32 mask             = 0;
+                for (std::size_t q = 0; q < 4; q++)
+                {
+                    const __m128i less = _mm_cmpgt_epi64(x, quarters[q]);
+                    mask |= static_cast<u32>(_mm_movemask_pd(_mm_castsi128_pd(less))) << (2 * q);
+                }
+                return std::popcount(mask);
+            }
+#endif
+#endif
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < node_sz; i++)
+            {
+                count += block.keys_[i] < probe ? 1 : 0;
+            }
+            return count;
+        }
+
+        arena_vector<node> nodes_;
+        arena_vector<u32> ranks_;
+    };
+};
+} // namespace flat_layout
+
+/**
+ * @brief A sorted set of unique keys in one contiguous array, searched through a `flat_layout`.
+ *
+ * Storage is pulled from a `std::pmr::memory_resource`, typically a `jc::memory::base_allocator`. The set is meant to
+ * be loaded in bulk with `assign_sorted()` and then mostly read: `insert` and `erase` shift the keys and rebuild the
+ * layout's index, both O(n). Keys are required to be trivially copyable so that every move is a plain memcpy.
+ *
+ * Like the rest of the library nothing here throws: operations that may allocate return false on failure.
+ *
+ * Note: This implementation is NOT thread-safe.
+ */
+template <typename K, typename Layout = flat_layout::sorted>
+    requires std::is_trivially_copyable_v<K>
+class flat_set
+{
+public:
+    explicit flat_set(std::pmr::memory_resource &resource) noexcept : keys_(resource), index_(resource)
+    {
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return keys_.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return keys_.empty();
+    }
+
+    void clear() noexcept
+    {
+        keys_.clear();
+        index_.build(keys());
+    }
+
+    bool reserve(const std::size_t n) noexcept
+    {
+        return keys_.reserve(n);
+    }
+
+    /**
+     * @brief Replaces the contents with `sorted`, which has to be strictly increasing: one copy and one index build.
+     * @return false if `sorted` isn't strictly increasing or memory ran out, the set is then empty.
+     */
+    bool assign_sorted(const std::span<const K> sorted) noexcept
+    {
+        const bool increasing =
+            std::adjacent_find(sorted.begin(), sorted.end(), [](const K &a, const K &b) { return !(a < b); }) ==
+            sorted.end();
+        keys_.clear();
+        if (increasing && keys_.resize(sorted.size()))
+        {
+            std::copy(sorted.begin(), sorted.end(), keys_.begin());
+            if (index_.build(keys()))
+            {
+                return true;
+            }
+        }
+        clear();
+        return false;
+    }
+
+    /**
+     * @return false if `key` was already there or memory ran out, the set is then unchanged.
+     */
+    bool insert(const K &key) noexcept
+    {
+        const std::size_t rank = lower_bound(key);
+        if ((rank < size() && !(key < keys_[rank])) || !keys_.insert(rank, key))
+        {
+            return false;
+        }
+        if (!index_.build(keys()))
+        {
+            keys_.erase(rank);
+            index_.build(keys());
+            return false;
+        }
+        return true;
+    }
+
+    bool erase(const K &key) noexcept
+    {
+        const std::size_t rank = index_of(key);
+        if (rank == size())
+        {
+            return false;
+        }
+        keys_.erase(rank);
+        // never needs more memory than the build before it
+        index_.build(keys());
+        return true;
+    }
+
+    /**
+     * @brief Position of the first key not less than `key`, `size()` if there is none.
+     */
+    [[nodiscard]] std::size_t lower_bound(const K &key) const noexcept
+    {
+        return index_.lower_bound(keys(), key);
+    }
+
+    /**
+     * @brief Position of `key`, `size()` if it isn't there.
+     */
+    [[nodiscard]] std::size_t index_of(const K &key) const noexcept
+    {
+        const std::size_t rank = lower_bound(key);
+        return rank < size() && !(key < keys_[rank]) ? rank : size();
+    }
+
+    [[nodiscard]] bool contains(const K &key) const noexcept
+    {
+        return index_of(key) != size();
+    }
+
+    [[nodiscard]] std::span<const K> keys() const noexcept
+    {
+        return {keys_.data(), keys_.size()};
+    }
+
+private:
+    arena_vector<K> keys_;
+    typename Layout::template index<K> index_;
+};
+
+/**
+ * @brief A sorted map keeping its keys in a `flat_set` and its values in a separate array in the same order, so a
+ * find only reads the keys (through the layout) and then the one value it returns.
+ *
+ * Same storage and update rules as `flat_set`: load in bulk with `assign_sorted()`, `insert`/`erase` are O(n). Values
+ * are required to be trivially copyable as well.
+ */
+template <typename K, typename V, typename Layout = flat_layout::sorted>
+    requires std::is_trivially_copyable_v<V>
+class flat_map
+{
+public:
+    explicit flat_map(std::pmr::memory_resource &resource) noexcept : keys_(resource), values_(resource)
+    {
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return keys_.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return keys_.empty();
+    }
+
+    void clear() noexcept
+    {
+        keys_.clear();
+        values_.clear();
+    }
+
+    bool reserve(const std::size_t n) noexcept
+    {
+        return keys_.reserve(n) && values_.reserve(n);
+    }
+
+    /**
+     * @brief Replaces the contents with `keys[i] -> values[i]`, `keys` has to be strictly increasing.
+     * @return false if the spans differ in length, `keys` isn't strictly increasing or memory ran out, the map is
+     * then empty.
+     */
+    bool assign_sorted(const std::span<const K> keys, const std::span<const V> values) noexcept
+    {
+        values_.clear();
+        if (keys.size() != values.size() || !values_.resize(values.size()) || !keys_.assign_sorted(keys))
+        {
+            clear();
+            return false;
+        }
+        std::copy(values.begin(), values.end(), values_.begin());
+        return true;
+    }
+
+    /**
+     * @return false if `key` was already there or memory ran out, the map is then unchanged.
+     */
+    bool insert(const K &key, const V &value) noexcept
+    {
+        const std::size_t rank = keys_.lower_bound(key);
+        if (!keys_.insert(key))
+        {
+            return false;
+        }
+        if (!values_.insert(rank, value))
+        {
+            keys_.erase(key);
+            return false;
+        }
+        return true;
+    }
+
+    bool erase(const K &key) noexcept
+    {
+        const std::size_t rank = keys_.index_of(key);
+        if (rank == size())
+        {
+            return false;
+        }
+        keys_.erase(key);
+        values_.erase(rank);
+        return true;
+    }
+
+    /**
+     * @return the value stored under `key`, or nullptr if there is none.
+     */
+    [[nodiscard]] V *find(const K &key) noexcept
+    {
+        const std::size_t rank = keys_.index_of(key);
+        return rank == size() ? nullptr : &values_[rank];
+    }
+
+    [[nodiscard]] const V *find(const K &key) const noexcept
+    {
+        return const_cast<flat_map *>(this)->find(key);
+    }
+
+    [[nodiscard]] bool contains(const K &key) const noexcept
+    {
+        return keys_.contains(key);
+    }
+
+    /**
+     * @brief Position of the first key not less than `key` in `keys()`/`values()`, `size()` if there is none.
+     */
+    [[nodiscard]] std::size_t lower_bound(const K &key) const noexcept
+    {
+        return keys_.lower_bound(key);
+    }
+
+    [[nodiscard]] std::span<const K> keys() const noexcept
+    {
+        return keys_.keys();
+    }
+
+    [[nodiscard]] std::span<V> values() noexcept
+    {
+        return {values_.data(), values_.size()};
+    }
+
+    [[nodiscard]] std::span<const V> values() const noexcept
+    {
+        return {values_.data(), values_.size()};
+    }
+
+private:
+    flat_set<K, Layout> keys_;
+    arena_vector<V> values_;
+};
+
+} // namespace jc::collections
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef JC_LOOKUP_TABLE_H
+#define JC_LOOKUP_TABLE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+#include <jc_collections/collections/fixed_vector.hpp>
+
+namespace jc::collections
+{
+
+namespace table_storage
+{
+/*
+ * where a lookup table keeps its keys and values: inline, so the table can be built in a constant expression and
+ * placed in .rodata, or in a memory resource at runtime. Both vectors have the same interface, the table is written
+ * once against it.
+ */
+template <std::size_t capacity>
+struct fixed
+{
+    template <typename T>
+    using vector = fixed_vector<T, capacity>;
+};
+
+struct arena
+{
+    template <typename T>
+    using vector = arena_vector<T>;
+};
+} // namespace table_storage
+
+/**
+ * @brief An immutable sorted map for lookup tables such as tick size ladders and symbol maps.
+ *
+ * Keys and values are stored in separate arrays, so a search only walks the keys. The entries are copied in and
+ * sorted once at construction, if they aren't sorted already, and the table never changes afterwards.
+ *
+ * With `table_storage::fixed` everything is constexpr: build it in a constexpr initializer (see
+ * `make_static_lookup_table`) and it is computed by the compiler and emitted into `.rodata`. With
+ * `table_storage::arena` it is built at runtime into a `std::pmr::memory_resource`, typically a
+ * `jc::memory::base_allocator`, passed after the entries.
+ *
+ * It does not throw on unsuccessful construction, instead call `successful_init()`: it is false if the storage ran
+ * out or a key appears twice, the table is then empty. For a static table, `static_assert` it.
+ */
+template <typename K, typename V, typename Storage>
+class basic_lookup_table
+{
+public:
+    using entry = std::pair<K, V>;
+
+    template <typename... Resource>
+    constexpr explicit basic_lookup_table(const std::span<const entry> entries, Resource &...resource) noexcept
+        : keys_(resource...), values_(resource...)
+    {
+        ok_ = keys_.reserve(entries.size()) && values_.reserve(entries.size());
+        for (std::size_t i = 0; ok_ && i < entries.size(); i++)
+        {
+            ok_ = keys_.push_back(entries[i].first) && values_.push_back(entries[i].second);
+        }
+        if (ok_ && !std::is_sorted(keys_.begin(), keys_.end()))
+        {
+            sort_rows();
+        }
+        ok_ = ok_ && std::adjacent_find(keys_.begin(), keys_.end(), [](const K &a, const K &b) {
+                         return !(a < b);
+                     }) == keys_.end();
+        if (!ok_)
+        {
+            keys_.clear();
+            values_.clear();
+        }
+    }
+
+    [[nodiscard]] constexpr bool successful_init() const noexcept
+    {
+        return ok_;
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept
+    {
+        return keys_.size();
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return keys_.empty();
+    }
+
+    /**
+     * @brief Index of the first key not less than `key`, `size()` if there is none.
+     */
+    [[nodiscard]] constexpr std::size_t lower_bound(const K &key) const noexcept
+    {
+        return static_cast<std::size_t>(std::lower_bound(keys_.begin(), keys_.end(), key) - keys_.begin());
+    }
+
+    /**
+     * @return the value stored under `key`, or nullptr if there is none.
+     */
+    [[nodiscard]] constexpr const V *find(const K &key) const noexcept
+    {
+        const std::size_t idx = lower_bound(key);
+        return idx < size() && !(key < keys_[idx]) ? &values_[idx] : nullptr;
+    }
+
+    /**
+     * @brief Range lookup, e.g. the tick size of the band a price falls in.
+     * @return the value under the greatest key not greater than `key`, or nullptr if every key is greater.
+     */
+    [[nodiscard]] constexpr const V *floor(const K &key) const noexcept
+    {
+        const auto idx = static_cast<std::size_t>(std::upper_bound(keys_.begin(), keys_.end(), key) - keys_.begin());
+        return idx == 0 ? nullptr : &values_[idx - 1];
+    }
+
+    [[nodiscard]] constexpr bool contains(const K &key) const noexcept
+    {
+        return find(key) != nullptr;
+    }
+
+    [[nodiscard]] constexpr std::span<const K> keys() const noexcept
+    {
+        return {keys_.data(), keys_.size()};
+    }
+
+    [[nodiscard]] constexpr std::span<const V> values() const noexcept
+    {
+        return {values_.data(), values_.size()};
+    }
+
+private:
+    // heapsort: in place, constexpr, and moves keys and values together. Raw pointers keep constant evaluation cheap.
+    constexpr void sort_rows() noexcept
+    {
+        K *keys             = keys_.data();
+        V *values           = values_.data();
+        const std::size_t n = keys_.size();
+        for (std::size_t i = n / 2; i-- > 0;)
+        {
+            sift_down(keys, values, i, n);
+        }
+        for (std::size_t last = n; last-- > 1;)
+        {
+            std::swap(keys[0], keys[last]);
+            std::swap(values[0], values[last]);
+            sift_down(keys, values, 0, last);
+        }
+    }
+
+    static constexpr void sift_down(K *keys, V *values, std::size_t root, const std::size_t n) noexcept
+    {
+        for (std::size_t child = 2 * root + 1; child < n; child = 2 * root + 1)
+        {
+            if (child + 1 < n && keys[child] < keys[child + 1])
+            {
+                ++child;
+            }
+            if (!(keys[root] < keys[child]))
+            {
+                return;
+            }
+            std::swap(keys[root], keys[child]);
+            std::swap(values[root], values[child]);
+            root = child;
+        }
+    }
+
+    typename Storage::template vector<K> keys_;
+    typename Storage::template vector<V> values_;
+    bool ok_ = false;
+};
+
+template <typename K, typename V, std::size_t capacity>
+using static_lookup_table = basic_lookup_table<K, V, table_storage::fixed<capacity>>;
+
+template <typename K, typename V>
+using arena_lookup_table = basic_lookup_table<K, V, table_storage::arena>;
+
+/**
+ * @brief Builds a table sized exactly for `entries`, meant for constexpr initializers:
+ * `static constexpr auto ladder = make_static_lookup_table(ladder_entries());`
+ */
+template <typename K, typename V, std::size_t n>
+constexpr static_lookup_table<K, V, n> make_static_lookup_table(const std::array<std::pair<K, V>, n> &entries) noexcept
+{
+    return static_lookup_table<K, V, n>(entries);
+}
+
+} // namespace jc::collections
+
+#endif
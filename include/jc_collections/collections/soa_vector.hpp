@@ -0,0 +1,331 @@
+#ifndef JC_SOA_VECTOR_H
+#define JC_SOA_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace jc::collections
+{
+
+/**
+ * @brief A structure-of-arrays vector, each of `Fields...` is stored in its own contiguous column.
+ *
+ * Scanning a single field only touches that field's column, and every column is aligned to `column_alignment` so
+ * that `column<I>()` spans can be handed straight to vectorized loops. Rows are accessed through tuple-like proxies
+ * of references (`std::tuple<Fields &...>`), which support structured bindings.
+ *
+ * Storage is pulled from a `std::pmr::memory_resource`, typically a `jc::memory::base_allocator`. Since an arena
+ * does not reclaim memory on deallocate, callers should `reserve()` the expected row count up front. Fields are
+ * required to be trivially copyable so that growth and bulk appends are plain memcpys.
+ *
+ * Like the rest of the library nothing here throws: operations that may allocate return false on failure and leave
+ * the container unchanged.
+ *
+ * Note: This implementation is NOT thread-safe.
+ */
+template <typename... Fields>
+    requires(sizeof...(Fields) > 0) && (std::is_trivially_copyable_v<Fields> && ...) &&
+            (std::is_trivially_destructible_v<Fields> && ...)
+class soa_vector
+{
+public:
+    static constexpr std::size_t column_count     = sizeof...(Fields);
+    static constexpr std::size_t column_alignment = std::max({std::size_t{64}, alignof(Fields)...});
+
+    template <std::size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    using reference       = std::tuple<Fields &...>;
+    using const_reference = std::tuple<const Fields &...>;
+    using value_type      = std::tuple<Fields...>;
+
+    explicit soa_vector(std::pmr::memory_resource &resource) noexcept : resource_(&resource)
+    {
+    }
+
+    soa_vector(std::pmr::memory_resource &resource, const std::size_t capacity) noexcept : resource_(&resource)
+    {
+        reserve(capacity);
+    }
+
+    ~soa_vector() noexcept
+    {
+        release();
+    }
+
+    // columns are owned by this object, copying would lead to a double free
+    soa_vector(const soa_vector &)            = delete;
+    soa_vector &operator=(const soa_vector &) = delete;
+
+    soa_vector(soa_vector &&other) noexcept
+        : resource_(other.resource_), columns_(other.columns_), size_(other.size_), capacity_(other.capacity_)
+    {
+        other.columns_  = {};
+        other.size_     = 0;
+        other.capacity_ = 0;
+    }
+
+    soa_vector &operator=(soa_vector &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            resource_       = other.resource_;
+            columns_        = other.columns_;
+            size_           = other.size_;
+            capacity_       = other.capacity_;
+            other.columns_  = {};
+            other.size_     = 0;
+            other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    void clear() noexcept
+    {
+        size_ = 0;
+    }
+
+    /**
+     * @brief Ensures space for at least `n` rows.
+     * @return false if the upstream resource could not provide the memory, the container is left untouched.
+     */
+    bool reserve(const std::size_t n) noexcept
+    {
+        if (n <= capacity_)
+        {
+            return true;
+        }
+        return reallocate(n, std::index_sequence_for<Fields...>{});
+    }
+
+    /**
+     * @brief Appends a single row, growing geometrically if needed.
+     */
+    bool push_back(const Fields &...fields) noexcept
+    {
+        if (size_ == capacity_ && !grow(size_ + 1))
+        {
+            return false;
+        }
+        write_row(size_, std::index_sequence_for<Fields...>{}, fields...);
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @brief Appends `n` rows at once, one memcpy per column.
+     *
+     * Each span must hold the same number of elements, otherwise nothing is appended and false is returned.
+     */
+    bool append(std::span<const Fields>... columns) noexcept
+    {
+        const std::size_t n = std::get<0>(std::tie(columns...)).size();
+        if (((columns.size() != n) || ...))
+        {
+            return false;
+        }
+        if (n == 0)
+        {
+            // nothing to copy, and the columns may still be null before the first grow
+            return true;
+        }
+        if (size_ + n > capacity_ && !grow(size_ + n))
+        {
+            return false;
+        }
+        copy_columns(size_, n, std::index_sequence_for<Fields...>{}, columns...);
+        size_ += n;
+        return true;
+    }
+
+    void pop_back() noexcept
+    {
+        if (size_ > 0)
+        {
+            --size_;
+        }
+    }
+
+    [[nodiscard]] reference operator[](const std::size_t idx) noexcept
+    {
+        return row(idx, std::index_sequence_for<Fields...>{});
+    }
+
+    [[nodiscard]] const_reference operator[](const std::size_t idx) const noexcept
+    {
+        return row(idx, std::index_sequence_for<Fields...>{});
+    }
+
+    /**
+     * @brief Access a single field of a row without materialising the whole row proxy.
+     */
+    template <std::size_t I>
+    [[nodiscard]] field_type<I> &get(const std::size_t idx) noexcept
+    {
+        return data<I>()[idx];
+    }
+
+    template <std::size_t I>
+    [[nodiscard]] const field_type<I> &get(const std::size_t idx) const noexcept
+    {
+        return data<I>()[idx];
+    }
+
+    /**
+     * @brief Pointer to the start of a column, aligned to `column_alignment`.
+     */
+    template <std::size_t I>
+    [[nodiscard]] field_type<I> *data() noexcept
+    {
+        return std::assume_aligned<column_alignment>(static_cast<field_type<I> *>(columns_[I]));
+    }
+
+    template <std::size_t I>
+    [[nodiscard]] const field_type<I> *data() const noexcept
+    {
+        return std::assume_aligned<column_alignment>(static_cast<const field_type<I> *>(columns_[I]));
+    }
+
+    /**
+     * @brief The live rows of a column, intended to be fed to vectorized loops.
+     */
+    template <std::size_t I>
+    [[nodiscard]] std::span<field_type<I>> column() noexcept
+    {
+        return {data<I>(), size_};
+    }
+
+    template <std::size_t I>
+    [[nodiscard]] std::span<const field_type<I>> column() const noexcept
+    {
+        return {data<I>(), size_};
+    }
+
+private:
+    template <std::size_t I>
+    static constexpr std::size_t column_bytes(const std::size_t n) noexcept
+    {
+        return n * sizeof(field_type<I>);
+    }
+
+    template <std::size_t... Is>
+    reference row(const std::size_t idx, std::index_sequence<Is...>) noexcept
+    {
+        return reference(data<Is>()[idx]...);
+    }
+
+    template <std::size_t... Is>
+    const_reference row(const std::size_t idx, std::index_sequence<Is...>) const noexcept
+    {
+        return const_reference(data<Is>()[idx]...);
+    }
+
+    template <std::size_t... Is>
+    void write_row(const std::size_t idx, std::index_sequence<Is...>, const Fields &...fields) noexcept
+    {
+        ((data<Is>()[idx] = fields), ...);
+    }
+
+    template <std::size_t... Is>
+    void copy_columns(const std::size_t offset, const std::size_t n, std::index_sequence<Is...>,
+                      std::span<const Fields>... columns) noexcept
+    {
+        (std::memcpy(data<Is>() + offset, columns.data(), column_bytes<Is>(n)), ...);
+    }
+
+    bool grow(const std::size_t needed) noexcept
+    {
+        // start at a cache line's worth of the smallest field so tiny vectors don't reallocate repeatedly
+        constexpr std::size_t min_capacity = column_alignment / std::min({sizeof(Fields)...});
+        return reserve(std::max({needed, capacity_ * 2, min_capacity}));
+    }
+
+    template <std::size_t... Is>
+    bool reallocate(const std::size_t n, std::index_sequence<Is...>) noexcept
+    {
+        std::array<void *, column_count> fresh{};
+        bool ok = true;
+        // allocate every column before touching the old ones so a failure leaves the vector as it was
+        ((ok = ok && (fresh[Is] = allocate_column(column_bytes<Is>(n))) != nullptr), ...);
+        if (!ok)
+        {
+            ((fresh[Is] != nullptr ? resource_->deallocate(fresh[Is], column_bytes<Is>(n), column_alignment)
+                                   : void()),
+             ...);
+            return false;
+        }
+
+        // the columns are still null on the first grow, and memcpy from null is undefined even for zero bytes
+        if (size_ != 0)
+        {
+            (std::memcpy(fresh[Is], columns_[Is], column_bytes<Is>(size_)), ...);
+        }
+        release();
+        columns_  = fresh;
+        capacity_ = n;
+        return true;
+    }
+
+    void *allocate_column(const std::size_t bytes) noexcept
+    {
+        // pmr resources report failure by throwing, base_allocator reports it by returning nullptr
+        try
+        {
+            return resource_->allocate(bytes, column_alignment);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    void release() noexcept
+    {
+        if (capacity_ == 0)
+        {
+            return;
+        }
+        release_columns(std::index_sequence_for<Fields...>{});
+        columns_  = {};
+        capacity_ = 0;
+    }
+
+    template <std::size_t... Is>
+    void release_columns(std::index_sequence<Is...>) noexcept
+    {
+        (resource_->deallocate(columns_[Is], column_bytes<Is>(capacity_), column_alignment), ...);
+    }
+
+    std::pmr::memory_resource *resource_;
+    std::array<void *, column_count> columns_{};
+    std::size_t size_     = 0;
+    std::size_t capacity_ = 0;
+};
+
+} // namespace jc::collections
+
+#endif
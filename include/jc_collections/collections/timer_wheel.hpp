@@ -0,0 +1,332 @@
+#ifndef JC_TIMER_WHEEL_H
+#define JC_TIMER_WHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+
+#include <jc_collections/collections/bitset.hpp>
+#include <jc_collections/lockfree/spsc.hpp>
+#include <jc_collections/memory/cached_pool_allocator.hpp>
+#include <jc_collections/util.h>
+
+namespace jc::collections
+{
+
+/**
+ * @brief A timer owned by a timer_wheel, returned from schedule() and accepted by cancel().
+ *
+ * A handle is only valid until its timer fires or is cancelled, after which the node is returned to the pool.
+ */
+struct timer_node
+{
+    u64 deadline_;
+    u64 user_data_;
+    timer_node *prev_;
+    timer_node *next_;
+    u8 level_;
+    u8 slot_;
+};
+
+/**
+ * @brief A request to schedule a timer from another thread, pushed through the wheel's inbox.
+ */
+struct timer_request
+{
+    u64 deadline_;
+    u64 user_data_;
+};
+
+/**
+ * @brief Hierarchical hashed timer wheel with O(1) schedule and cancel.
+ *
+ * Time is measured in caller defined ticks. The wheel has four levels of 256 slots, level k slots span 256^k ticks, so
+ * timers up to 2^32 ticks ahead are placed directly and anything further is parked in the top level and re-hashed as
+ * the wheel turns. When a lower level wraps, the matching slot of the level above is cascaded down. Each level keeps
+ * slot occupancy in a scalar_bitset so advancing skips runs of empty slots instead of visiting every tick.
+ *
+ * Timer nodes come from a cached_pool_allocator sized for `capacity` live timers and are recycled through a free list,
+ * so scheduling never touches the heap. The pool draws its nodes from `upstream` once, at construction; it does not
+ * throw, call `successful_init()` to check it got them.
+ *
+ * The wheel is owned by one thread. Other threads schedule by pushing a timer_request into `inbox()`, which is drained
+ * on every call to advance().
+ *
+ * Note: This implementation is NOT thread-safe apart from the inbox.
+ */
+template <std::size_t capacity, std::size_t inbox_size = 1024>
+class timer_wheel
+{
+public:
+    static constexpr std::size_t level_count = 4;
+    static constexpr std::size_t slot_bits   = 8;
+    static constexpr std::size_t slot_count  = std::size_t{1} << slot_bits;
+    static constexpr u64 slot_mask           = slot_count - 1;
+
+    using inbox_type = lockfree::cached_spsc<timer_request, inbox_size>;
+
+    /**
+     * @param upstream passed through to the node pool
+     * @param now the tick the wheel starts at
+     */
+    explicit timer_wheel(std::pmr::memory_resource &upstream, const u64 now = 0) noexcept
+        : nodes_(upstream), current_(now)
+    {
+    }
+
+    timer_wheel(const timer_wheel &)            = delete;
+    timer_wheel &operator=(const timer_wheel &) = delete;
+    timer_wheel(timer_wheel &&)                 = delete;
+    timer_wheel &operator=(timer_wheel &&)      = delete;
+
+    /**
+     * @brief Checks the node pool got its storage from the upstream, without it every schedule() fails.
+     */
+    [[nodiscard]] bool successful_init() const noexcept
+    {
+        return nodes_.successful_init();
+    }
+
+    /**
+     * @brief Schedules a timer, deadlines at or before the current tick fire on the next advance().
+     * @return a handle for cancel(), or nullptr if `capacity` timers are already live.
+     */
+    [[nodiscard]] timer_node *schedule(const u64 deadline, const u64 user_data) noexcept
+    {
+        timer_node *node = acquire_node();
+        if (node == nullptr) [[unlikely]]
+        {
+            return nullptr;
+        }
+        node->deadline_  = deadline;
+        node->user_data_ = user_data;
+        // the current tick's level 0 slot has already been expired, so overdue timers go in the next one
+        insert(node, current_ + 1);
+        ++size_;
+        return node;
+    }
+
+    /**
+     * @brief Cancels a pending timer, the handle must not be used afterwards.
+     */
+    void cancel(timer_node *node) noexcept
+    {
+        if (node == nullptr)
+        {
+            return;
+        }
+        unlink(node);
+        release_node(node);
+        --size_;
+    }
+
+    /**
+     * @brief Moves the wheel forward to `now`, calling `on_expire(deadline, user_data)` for every timer that is due.
+     * @return the number of timers that fired.
+     */
+    template <typename F>
+    std::size_t advance(const u64 now, F &&on_expire)
+    {
+        drain_inbox();
+
+        std::size_t fired = 0;
+        while (current_ < now)
+        {
+            u64 tick = current_ + 1;
+            if ((tick & slot_mask) != 0)
+            {
+                // inside a level 0 rotation nothing cascades, so jump straight to the next occupied slot
+                const i64 next       = occupied_[0].find_next_set(tick & slot_mask);
+                const u64 round_end  = (tick | slot_mask) + 1;
+                const u64 next_event = next >= 0 ? (tick & ~slot_mask) + static_cast<u64>(next) : round_end;
+                if (next_event > now)
+                {
+                    current_ = now;
+                    break;
+                }
+                if (next_event == round_end)
+                {
+                    current_ = round_end - 1;
+                    continue;
+                }
+                tick = next_event;
+            }
+            else
+            {
+                current_ = tick;
+                cascade(tick);
+            }
+
+            current_ = tick;
+            fired += expire(tick & slot_mask, on_expire);
+        }
+        return fired;
+    }
+
+    /**
+     * @brief Single producer inbox for scheduling from another thread, requests land on the next advance().
+     */
+    [[nodiscard]] inbox_type &inbox() noexcept
+    {
+        return inbox_;
+    }
+
+    [[nodiscard]] u64 now() const noexcept
+    {
+        return current_;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+private:
+    void insert(timer_node *node, const u64 earliest) noexcept
+    {
+        const u64 deadline = node->deadline_ > earliest ? node->deadline_ : earliest;
+        const u64 delta    = deadline - current_;
+
+        std::size_t level = 0;
+        while (level + 1 < level_count && delta >= (u64{1} << (slot_bits * (level + 1))))
+        {
+            ++level;
+        }
+
+        // beyond the top level the timer is parked in its furthest slot and re-hashed when that slot cascades
+        const u64 horizon = u64{1} << (slot_bits * level_count);
+        const u64 placed  = delta < horizon ? deadline : current_ + horizon - (u64{1} << (slot_bits * level));
+        const auto slot   = static_cast<std::size_t>((placed >> (slot_bits * level)) & slot_mask);
+
+        node->level_ = static_cast<u8>(level);
+        node->slot_  = static_cast<u8>(slot);
+        node->prev_  = nullptr;
+        node->next_  = slots_[level][slot];
+        if (node->next_ != nullptr)
+        {
+            node->next_->prev_ = node;
+        }
+        slots_[level][slot] = node;
+        occupied_[level].set_bit(slot);
+    }
+
+    void unlink(timer_node *node) noexcept
+    {
+        timer_node *&head = slots_[node->level_][node->slot_];
+        if (node->prev_ != nullptr)
+        {
+            node->prev_->next_ = node->next_;
+        }
+        else
+        {
+            head = node->next_;
+        }
+        if (node->next_ != nullptr)
+        {
+            node->next_->prev_ = node->prev_;
+        }
+        if (head == nullptr)
+        {
+            occupied_[node->level_].unset_bit(node->slot_);
+        }
+    }
+
+    /**
+     * @brief Re-hashes the slots of every level that wrapped at `tick`, highest level first so timers can fall more
+     * than one level.
+     */
+    void cascade(const u64 tick) noexcept
+    {
+        std::size_t top = 0;
+        while (top + 1 < level_count && (tick & ((u64{1} << (slot_bits * (top + 1))) - 1)) == 0)
+        {
+            ++top;
+        }
+
+        for (std::size_t level = top; level > 0; level--)
+        {
+            const auto slot  = static_cast<std::size_t>((tick >> (slot_bits * level)) & slot_mask);
+            timer_node *node = slots_[level][slot];
+            slots_[level][slot] = nullptr;
+            occupied_[level].unset_bit(slot);
+            while (node != nullptr)
+            {
+                timer_node *next = node->next_;
+                // the wheel is sitting on `tick` and its level 0 slot is expired next, so timers due now land there
+                insert(node, tick);
+                node = next;
+            }
+        }
+    }
+
+    template <typename F>
+    std::size_t expire(const std::size_t slot, F &on_expire)
+    {
+        timer_node *node = slots_[0][slot];
+        slots_[0][slot]  = nullptr;
+        occupied_[0].unset_bit(slot);
+
+        std::size_t fired = 0;
+        while (node != nullptr)
+        {
+            timer_node *next     = node->next_;
+            const u64 deadline   = node->deadline_;
+            const u64 user_data  = node->user_data_;
+            release_node(node);
+            --size_;
+            ++fired;
+            on_expire(deadline, user_data);
+            node = next;
+        }
+        return fired;
+    }
+
+    /**
+     * @brief Fired and cancelled nodes are kept on an intrusive free list. The pool only frees a block once every node
+     * in it is returned, and timers allocated together rarely die together, so recycling nodes here keeps the wheel
+     * from running the pool dry.
+     */
+    timer_node *acquire_node() noexcept
+    {
+        if (free_ != nullptr)
+        {
+            timer_node *node = free_;
+            free_            = node->next_;
+            return node;
+        }
+        return nodes_.allocate(1);
+    }
+
+    void release_node(timer_node *node) noexcept
+    {
+        node->next_ = free_;
+        free_       = node;
+    }
+
+    void drain_inbox() noexcept
+    {
+        while (const std::optional<timer_request> request = inbox_.try_read())
+        {
+            // requests that don't fit are dropped, same as a local schedule() returning nullptr
+            (void)schedule(request->deadline_, request->user_data_);
+        }
+    }
+
+    memory::cached_pool_allocator<timer_node, capacity, std::pmr::memory_resource> nodes_;
+    std::array<std::array<timer_node *, slot_count>, level_count> slots_{};
+    std::array<scalar_bitset<slot_count>, level_count> occupied_{};
+    inbox_type inbox_;
+    timer_node *free_ = nullptr;
+    u64 current_      = 0;
+    std::size_t size_ = 0;
+};
+
+} // namespace jc::collections
+
+#endif
@@ -0,0 +1,467 @@
+#ifndef JC_INGEST_H
+#define JC_INGEST_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <span>
+
+#include <linux/io_uring.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <jc_collections/lockfree/spsc.hpp>
+#include <jc_collections/memory/base_allocator.hpp>
+#include <jc_collections/util.h>
+
+namespace jc::io
+{
+
+/*
+ * A received message as handed to the consumer. The bytes live in the ingest's buffer pool until the descriptor is
+ * given back with release().
+ */
+struct ingest_buffer
+{
+    u32 index_;
+    u32 size_;
+    i32 socket_;
+};
+
+enum class ingest_backend : u8
+{
+    io_uring,
+    epoll,
+};
+
+/*
+ * Socket reader that receives straight into a pool of fixed size buffers carved out of a base_allocator and passes
+ * descriptors to a single consumer through a cached_spsc ring. The consumer hands buffers back through a return ring,
+ * so a message is copied exactly once, by the kernel, and the steady state never allocates.
+ *
+ * With io_uring the whole pool is registered once and every socket keeps `depth` fixed buffer reads in flight, so a
+ * poll is a single io_uring_enter for any number of messages. When io_uring is unavailable, or when asked for, the
+ * same interface is served by level-triggered epoll with recv() into the pool.
+ *
+ * poll() must only be called from one thread and try_read()/release() from one other thread (or the same one).
+ * Stream sockets should keep a depth of 1, more than one read in flight on the same stream can complete out of order.
+ */
+template <std::size_t buffer_count = 1024, std::size_t buffer_size = 2048, std::size_t max_sockets = 16>
+    requires lockfree::is_power_of_two<buffer_count> && (buffer_size > 0) && (max_sockets > 0)
+class ingest
+{
+private:
+    struct socket_slot
+    {
+        i32 fd_        = -1;
+        u32 depth_     = 0;
+        u32 in_flight_ = 0;
+        bool open_     = false;
+    };
+
+    struct uring
+    {
+        int fd_                    = -1;
+        void *sq_ring_             = MAP_FAILED;
+        void *cq_ring_             = MAP_FAILED;
+        std::size_t sq_ring_bytes_ = 0;
+        std::size_t cq_ring_bytes_ = 0;
+        io_uring_sqe *sqes_        = static_cast<io_uring_sqe *>(MAP_FAILED);
+        std::size_t sqes_bytes_    = 0;
+
+        unsigned *sq_tail_  = nullptr;
+        unsigned sq_mask_   = 0;
+        unsigned *sq_array_ = nullptr;
+        unsigned *cq_head_  = nullptr;
+        unsigned *cq_tail_  = nullptr;
+        unsigned cq_mask_   = 0;
+        io_uring_cqe *cqes_ = nullptr;
+
+        unsigned to_submit_ = 0;
+    };
+
+public:
+    /**
+     * @brief Carves the buffer pool out of the arena and sets up the preferred backend, falling back to epoll if
+     * io_uring can't be used. It does not throw, call `successful_init()` to check the result.
+     */
+    explicit ingest(memory::base_allocator &arena, const ingest_backend preferred = ingest_backend::io_uring) noexcept
+    {
+        pool_ = static_cast<std::byte *>(arena.allocate(buffer_count * buffer_size, page_size));
+        if (pool_ == nullptr)
+        {
+            return;
+        }
+        for (u32 i = 0; i < buffer_count; i++)
+        {
+            free_[i] = static_cast<u32>(buffer_count - 1 - i);
+        }
+        free_count_ = buffer_count;
+
+        if (preferred == ingest_backend::io_uring && setup_uring())
+        {
+            backend_ = ingest_backend::io_uring;
+            ready_   = true;
+            return;
+        }
+        teardown_uring();
+
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        backend_  = ingest_backend::epoll;
+        ready_    = epoll_fd_ >= 0;
+    }
+
+    ~ingest() noexcept
+    {
+        teardown_uring();
+        if (epoll_fd_ >= 0)
+        {
+            close(epoll_fd_);
+        }
+    }
+
+    ingest(const ingest &)            = delete;
+    ingest &operator=(const ingest &) = delete;
+    ingest(ingest &&)                 = delete;
+    ingest &operator=(ingest &&)      = delete;
+
+    [[nodiscard]] bool successful_init() const noexcept
+    {
+        return ready_;
+    }
+
+    [[nodiscard]] ingest_backend backend() const noexcept
+    {
+        return backend_;
+    }
+
+    /**
+     * @brief Starts receiving from a connected or bound socket, the caller keeps ownership of the descriptor and its
+     * file status flags are left alone, a blocking socket works with either backend.
+     * @param depth number of receives kept in flight for this socket under io_uring, ignored by epoll.
+     * @return false if every socket slot is taken or the socket could not be registered.
+     */
+    bool add_socket(const int fd, const u32 depth = 1) noexcept
+    {
+        for (u32 slot = 0; slot < max_sockets; slot++)
+        {
+            socket_slot &socket = sockets_[slot];
+            if (socket.open_)
+            {
+                continue;
+            }
+
+            if (backend_ == ingest_backend::epoll)
+            {
+                epoll_event event{};
+                event.events   = EPOLLIN;
+                event.data.u32 = slot;
+                if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0)
+                {
+                    return false;
+                }
+            }
+
+            socket = socket_slot{fd, depth == 0 ? 1 : depth, 0, true};
+            if (backend_ == ingest_backend::io_uring)
+            {
+                arm(slot);
+                submit(false);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Recycles returned buffers and moves every completed receive to the consumer ring.
+     * @param block wait for at least one message when nothing is ready.
+     * @return the number of messages handed to the consumer.
+     */
+    std::size_t poll(const bool block = false) noexcept
+    {
+        recycle();
+        return backend_ == ingest_backend::io_uring ? poll_uring(block) : poll_epoll(block);
+    }
+
+    /*
+     * consumer side, the returned buffer stays valid until it is released.
+     */
+    [[nodiscard]] std::optional<ingest_buffer> try_read() noexcept
+    {
+        return ready_ring_.try_read();
+    }
+
+    [[nodiscard]] std::span<const std::byte> data(const ingest_buffer &buffer) const noexcept
+    {
+        return {pool_ + static_cast<std::size_t>(buffer.index_) * buffer_size, buffer.size_};
+    }
+
+    void release(const ingest_buffer &buffer) noexcept
+    {
+        // every buffer is in exactly one place, so the return ring can never be full
+        return_ring_.put(u32{buffer.index_});
+    }
+
+    /*
+     * buffers owned by the reactor and not in flight, a pool running dry means the consumer is falling behind. Only
+     * meaningful on the polling thread.
+     */
+    [[nodiscard]] std::size_t free_buffers() const noexcept
+    {
+        return free_count_;
+    }
+
+private:
+    static constexpr std::size_t page_size = 4096;
+    static constexpr u64 slot_shift        = 32;
+
+    void recycle() noexcept
+    {
+        bool returned = false;
+        while (std::optional<u32> index = return_ring_.try_read())
+        {
+            free_[free_count_++] = *index;
+            returned             = true;
+        }
+        if (returned && backend_ == ingest_backend::io_uring)
+        {
+            for (u32 slot = 0; slot < max_sockets; slot++)
+            {
+                arm(slot);
+            }
+        }
+    }
+
+    std::size_t poll_epoll(const bool block) noexcept
+    {
+        std::array<epoll_event, max_sockets> events;
+        const int ready = epoll_wait(epoll_fd_, events.data(), static_cast<int>(max_sockets), block ? -1 : 0);
+        std::size_t delivered = 0;
+        for (int i = 0; i < ready; i++)
+        {
+            const u32 slot      = events[i].data.u32;
+            socket_slot &socket = sockets_[slot];
+            // level triggered, whatever is left when the pool runs dry is picked up on a later poll
+            while (socket.open_ && free_count_ > 0)
+            {
+                const u32 index = free_[free_count_ - 1];
+                // non-blocking per call rather than through O_NONBLOCK, the descriptor belongs to the caller
+                const ssize_t received = recv(socket.fd_, pool_ + static_cast<std::size_t>(index) * buffer_size,
+                                              buffer_size, MSG_DONTWAIT);
+                if (received > 0)
+                {
+                    --free_count_;
+                    ready_ring_.put(ingest_buffer{index, static_cast<u32>(received), socket.fd_});
+                    ++delivered;
+                    continue;
+                }
+                if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+                {
+                    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, socket.fd_, nullptr);
+                    socket.open_ = false;
+                }
+                break;
+            }
+        }
+        return delivered;
+    }
+
+    std::size_t poll_uring(const bool block) noexcept
+    {
+        std::size_t delivered = reap();
+        if (delivered > 0 && uring_.to_submit_ == 0)
+        {
+            return delivered;
+        }
+        // submit re-armed reads and let the kernel run pending socket completions in the same call
+        submit(block && delivered == 0 && in_flight_ > 0);
+        return delivered + reap();
+    }
+
+    std::size_t reap() noexcept
+    {
+        std::size_t delivered = 0;
+        unsigned head         = *uring_.cq_head_;
+        const unsigned tail   = std::atomic_ref(*uring_.cq_tail_).load(std::memory_order::acquire);
+        for (; head != tail; ++head)
+        {
+            const io_uring_cqe &cqe = uring_.cqes_[head & uring_.cq_mask_];
+            const auto slot         = static_cast<u32>(cqe.user_data >> slot_shift);
+            const auto index        = static_cast<u32>(cqe.user_data);
+            socket_slot &socket     = sockets_[slot];
+            --socket.in_flight_;
+            --in_flight_;
+
+            if (cqe.res > 0)
+            {
+                ready_ring_.put(ingest_buffer{index, static_cast<u32>(cqe.res), socket.fd_});
+                ++delivered;
+                arm(slot);
+                continue;
+            }
+
+            free_[free_count_++] = index;
+            if (cqe.res == -EAGAIN || cqe.res == -EINTR)
+            {
+                arm(slot);
+            }
+            else
+            {
+                // end of stream or a hard error, stop reading from this socket
+                socket.open_ = false;
+            }
+        }
+        std::atomic_ref(*uring_.cq_head_).store(head, std::memory_order::release);
+        return delivered;
+    }
+
+    /*
+     * tops a socket's in flight reads back up to its depth while there are free buffers.
+     */
+    void arm(const u32 slot) noexcept
+    {
+        socket_slot &socket = sockets_[slot];
+        while (socket.open_ && socket.in_flight_ < socket.depth_ && free_count_ > 0)
+        {
+            const u32 index    = free_[--free_count_];
+            const unsigned tail = *uring_.sq_tail_ + uring_.to_submit_;
+            const unsigned idx  = tail & uring_.sq_mask_;
+
+            io_uring_sqe &sqe = uring_.sqes_[idx];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode    = IORING_OP_READ_FIXED;
+            sqe.fd        = socket.fd_;
+            sqe.addr      = reinterpret_cast<u64>(pool_ + static_cast<std::size_t>(index) * buffer_size);
+            sqe.len       = buffer_size;
+            sqe.off       = static_cast<u64>(-1);
+            sqe.buf_index = 0;
+            sqe.user_data = (static_cast<u64>(slot) << slot_shift) | index;
+
+            uring_.sq_array_[idx] = idx;
+            ++uring_.to_submit_;
+            ++socket.in_flight_;
+            ++in_flight_;
+        }
+    }
+
+    void submit(const bool wait) noexcept
+    {
+        const unsigned count = uring_.to_submit_;
+        // completions are read straight from the shared ring, the kernel only has to be entered to hand it work or to
+        // block
+        if (count == 0 && !wait)
+        {
+            return;
+        }
+        if (count > 0)
+        {
+            std::atomic_ref(*uring_.sq_tail_).store(*uring_.sq_tail_ + count, std::memory_order::release);
+            uring_.to_submit_ = 0;
+        }
+        syscall(__NR_io_uring_enter, uring_.fd_, count, wait ? 1u : 0u, IORING_ENTER_GETEVENTS, nullptr, 0);
+    }
+
+    bool setup_uring() noexcept
+    {
+        io_uring_params params{};
+        params.flags      = IORING_SETUP_CQSIZE;
+        params.cq_entries = buffer_count * 2;
+        uring_.fd_        = static_cast<int>(syscall(__NR_io_uring_setup, buffer_count, &params));
+        if (uring_.fd_ < 0)
+        {
+            return false;
+        }
+
+        uring_.sq_ring_bytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        uring_.cq_ring_bytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_map = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_map)
+        {
+            uring_.sq_ring_bytes_ = std::max(uring_.sq_ring_bytes_, uring_.cq_ring_bytes_);
+        }
+
+        uring_.sq_ring_ = mmap(nullptr, uring_.sq_ring_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                               uring_.fd_, IORING_OFF_SQ_RING);
+        if (uring_.sq_ring_ == MAP_FAILED)
+        {
+            return false;
+        }
+        uring_.cq_ring_ = single_map ? uring_.sq_ring_
+                                     : mmap(nullptr, uring_.cq_ring_bytes_, PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE, uring_.fd_, IORING_OFF_CQ_RING);
+        if (uring_.cq_ring_ == MAP_FAILED)
+        {
+            return false;
+        }
+        uring_.sqes_bytes_ = params.sq_entries * sizeof(io_uring_sqe);
+        void *sqes         = mmap(nullptr, uring_.sqes_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                  uring_.fd_, IORING_OFF_SQES);
+        uring_.sqes_       = static_cast<io_uring_sqe *>(sqes);
+        if (uring_.sqes_ == MAP_FAILED)
+        {
+            return false;
+        }
+
+        auto *sq         = static_cast<std::byte *>(uring_.sq_ring_);
+        auto *cq         = static_cast<std::byte *>(uring_.cq_ring_);
+        uring_.sq_tail_  = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        uring_.sq_mask_  = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        uring_.sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        uring_.cq_head_  = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        uring_.cq_tail_  = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        uring_.cq_mask_  = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        uring_.cqes_     = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+        // one registration covering the whole pool, every read then addresses a slice of buffer 0
+        iovec pool{pool_, buffer_count * buffer_size};
+        return syscall(__NR_io_uring_register, uring_.fd_, IORING_REGISTER_BUFFERS, &pool, 1) == 0;
+    }
+
+    void teardown_uring() noexcept
+    {
+        if (uring_.sqes_ != MAP_FAILED)
+        {
+            munmap(uring_.sqes_, uring_.sqes_bytes_);
+        }
+        if (uring_.cq_ring_ != MAP_FAILED && uring_.cq_ring_ != uring_.sq_ring_)
+        {
+            munmap(uring_.cq_ring_, uring_.cq_ring_bytes_);
+        }
+        if (uring_.sq_ring_ != MAP_FAILED)
+        {
+            munmap(uring_.sq_ring_, uring_.sq_ring_bytes_);
+        }
+        if (uring_.fd_ >= 0)
+        {
+            close(uring_.fd_);
+        }
+        uring_ = uring{};
+    }
+
+    lockfree::cached_spsc<ingest_buffer, buffer_count> ready_ring_;
+    lockfree::cached_spsc<u32, buffer_count> return_ring_;
+
+    std::byte *pool_ = nullptr;
+    std::array<u32, buffer_count> free_{};
+    std::size_t free_count_ = 0;
+    std::array<socket_slot, max_sockets> sockets_{};
+    std::size_t in_flight_ = 0;
+
+    uring uring_;
+    int epoll_fd_           = -1;
+    ingest_backend backend_ = ingest_backend::epoll;
+    bool ready_             = false;
+};
+
+} // namespace jc::io
+
+#endif
@@ -0,0 +1,553 @@
+#ifndef JC_JOURNAL_H
+#define JC_JOURNAL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <jc_collections/lockfree/spsc.hpp>
+#include <jc_collections/lockfree/thread_pool.hpp>
+#include <jc_collections/util.h>
+
+namespace jc::io
+{
+
+/*
+ * One journalled element, the layout on disk is exactly this struct so a reader can hand out pointers into the
+ * mapping.
+ */
+template <typename T>
+struct journal_record
+{
+    u64 sequence_;
+    u64 timestamp_ns_;
+    T payload_;
+};
+
+/*
+ * First bytes of every segment. count_ is only ever advanced by the writer after the records it covers are in the
+ * mapping, so a reader tailing a live segment never sees a torn record.
+ */
+struct journal_header
+{
+    static constexpr u64 magic = 0x4a434a524e4c3031; // "JCJRNL01"
+
+    u64 magic_;
+    u32 record_size_;
+    u32 records_offset_;
+    u64 capacity_;
+    u64 count_;
+};
+
+namespace detail
+{
+inline constexpr std::size_t journal_page_size = 4096;
+
+inline std::filesystem::path segment_path(const std::filesystem::path &directory, const std::string_view name,
+                                          const u32 index)
+{
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), ".%06u.jnl", index);
+    return directory / (std::string(name) + suffix);
+}
+
+template <typename T>
+constexpr std::size_t records_offset() noexcept
+{
+    return int_ceil(sizeof(journal_header), alignof(journal_record<T>)) * alignof(journal_record<T>);
+}
+
+inline u64 now_ns() noexcept
+{
+    return static_cast<u64>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+} // namespace detail
+
+/*
+ * Records everything a hot thread hands it into a series of pre-sized, memory mapped segment files, without the hot
+ * thread ever touching the file system. record() only timestamps the element and pushes it into a cached_spsc ring; a
+ * dedicated drain thread copies batches into the current segment and rotates to a new file when it fills up.
+ *
+ * Segments are named `<name>.<index>.jnl` inside `directory`, start at index 0 and are truncated if they already
+ * exist. Each one is page aligned in size, fully allocated up front and advised for sequential access.
+ *
+ * Note: a single thread may call record().
+ */
+template <typename T, std::size_t ring_size = 4096>
+    requires std::is_trivially_copyable_v<T> && lockfree::is_power_of_two<ring_size>
+class journal_writer
+{
+private:
+    struct entry
+    {
+        u64 timestamp_ns_;
+        T payload_;
+    };
+
+public:
+    using record_type = journal_record<T>;
+
+    /**
+     * @brief Creates the first segment. It does not throw, call `successful_init()` to check the result.
+     * @param segment_bytes size of each segment file, rounded up to whole pages.
+     */
+    journal_writer(std::filesystem::path directory, const std::string_view name,
+                   const std::size_t segment_bytes = std::size_t{64} << 20) noexcept
+        : directory_(std::move(directory)), name_(name),
+          segment_bytes_(int_ceil(std::max(segment_bytes, records_offset + sizeof(record_type)),
+                                  detail::journal_page_size) *
+                         detail::journal_page_size)
+    {
+        ready_ = open_segment(0);
+    }
+
+    ~journal_writer() noexcept
+    {
+        stop();
+        close_segment();
+    }
+
+    journal_writer(const journal_writer &)            = delete;
+    journal_writer &operator=(const journal_writer &) = delete;
+    journal_writer(journal_writer &&)                 = delete;
+    journal_writer &operator=(journal_writer &&)      = delete;
+
+    [[nodiscard]] bool successful_init() const noexcept
+    {
+        return ready_;
+    }
+
+    /**
+     * @brief Starts the drain thread, pinned to `core` when it is not negative.
+     */
+    void start(const int core = -1)
+    {
+        if (running_ || !ready_)
+        {
+            return;
+        }
+        stop_.store(false, std::memory_order::relaxed);
+        drain_thread_ = std::thread([this, core] {
+            if (core >= 0)
+            {
+                lockfree::pin_current_thread(core);
+            }
+            drain();
+        });
+        running_ = true;
+    }
+
+    /**
+     * @brief Writes out everything already recorded and joins the drain thread.
+     */
+    void stop()
+    {
+        if (!running_)
+        {
+            return;
+        }
+        stop_.store(true, std::memory_order::release);
+        drain_thread_.join();
+        running_ = false;
+    }
+
+    /**
+     * @brief Hot path, never blocks. Returns false and counts a drop if the drain thread has fallen a ring behind.
+     */
+    bool record(const T &element) noexcept
+    {
+        if (!ring_.try_put(entry{detail::now_ns(), element}))
+        {
+            // shared with the drain thread once segments can't be created, a full ring is the slow path anyway
+            dropped_.fetch_add(1, std::memory_order::relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] u64 written() const noexcept
+    {
+        return written_.load(std::memory_order::acquire);
+    }
+
+    [[nodiscard]] u64 dropped() const noexcept
+    {
+        return dropped_.load(std::memory_order::relaxed);
+    }
+
+    /*
+     * false once a segment could not be created. The writer does not retry, everything recorded after that is lost and
+     * counted in dropped().
+     */
+    [[nodiscard]] bool healthy() const noexcept
+    {
+        return healthy_.load(std::memory_order::relaxed);
+    }
+
+private:
+    static constexpr std::size_t records_offset = detail::records_offset<T>();
+    static constexpr std::size_t batch_size     = 256;
+    static constexpr std::size_t spin_limit     = 1024;
+
+    void drain()
+    {
+        std::size_t idle = 0;
+        while (true)
+        {
+            // read the flag first so the batch after it observes everything recorded before stop()
+            const bool stopping = stop_.load(std::memory_order::acquire);
+            const std::size_t count = drain_batch();
+            if (count > 0)
+            {
+                idle = 0;
+                continue;
+            }
+            if (stopping)
+            {
+                return;
+            }
+            if (++idle > spin_limit)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    std::size_t drain_batch() noexcept
+    {
+        std::size_t count = 0;
+        while (count < batch_size)
+        {
+            std::optional<entry> element = ring_.try_read();
+            if (!element)
+            {
+                break;
+            }
+            if (!healthy_.load(std::memory_order::relaxed) || (segment_count_ == capacity_ && !rotate()))
+            {
+                // nowhere to put it, keep draining so the hot thread is never blocked by a full disk
+                dropped_.fetch_add(1, std::memory_order::relaxed);
+                ++count;
+                continue;
+            }
+            record_type *slot   = records_ + segment_count_;
+            slot->sequence_     = sequence_++;
+            slot->timestamp_ns_ = element->timestamp_ns_;
+            std::memcpy(&slot->payload_, &element->payload_, sizeof(T));
+            ++segment_count_;
+            ++count;
+        }
+        if (count > 0)
+        {
+            // a failed rotation leaves no header, but the records before it were written and close_segment() kept them
+            if (header_ != nullptr)
+            {
+                std::atomic_ref(header_->count_).store(segment_count_, std::memory_order::release);
+            }
+            written_.store(sequence_, std::memory_order::release);
+        }
+        return count;
+    }
+
+    bool rotate() noexcept
+    {
+        close_segment();
+        if (!open_segment(segment_index_ + 1))
+        {
+            // latched, retrying would cost a failing open() for every element still to come
+            healthy_.store(false, std::memory_order::relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    bool open_segment(const u32 index) noexcept
+    {
+        std::filesystem::path path;
+        try
+        {
+            path = detail::segment_path(directory_, name_, index);
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            return false;
+        }
+        // reserve the blocks now so the drain thread never takes a page fault that has to allocate on disk
+        if (posix_fallocate(fd, 0, static_cast<off_t>(segment_bytes_)) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        void *mapping = mmap(nullptr, segment_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            return false;
+        }
+        madvise(mapping, segment_bytes_, MADV_SEQUENTIAL);
+
+        mapping_       = mapping;
+        header_        = static_cast<journal_header *>(mapping);
+        records_       = reinterpret_cast<record_type *>(static_cast<std::byte *>(mapping) + records_offset);
+        capacity_      = (segment_bytes_ - records_offset) / sizeof(record_type);
+        segment_count_ = 0;
+        segment_index_ = index;
+        *header_       = journal_header{journal_header::magic, sizeof(record_type), records_offset, capacity_, 0};
+        return true;
+    }
+
+    void close_segment() noexcept
+    {
+        if (mapping_ == nullptr)
+        {
+            return;
+        }
+        // a segment can fill up in the middle of a batch, commit its tail before letting go of it
+        std::atomic_ref(header_->count_).store(segment_count_, std::memory_order::release);
+        // hand the dirty pages to the kernel without waiting for them to hit the disk
+        msync(mapping_, segment_bytes_, MS_ASYNC);
+        munmap(mapping_, segment_bytes_);
+        mapping_ = nullptr;
+        header_  = nullptr;
+        records_ = nullptr;
+    }
+
+    lockfree::cached_spsc<entry, ring_size> ring_;
+    alignas(std::hardware_destructive_interference_size) std::atomic<u64> dropped_ = 0;
+    alignas(std::hardware_destructive_interference_size) std::atomic<u64> written_ = 0;
+    std::atomic<bool> healthy_ = true;
+    std::atomic<bool> stop_    = false;
+
+    // owned by the drain thread once started
+    std::filesystem::path directory_;
+    std::string name_;
+    std::size_t segment_bytes_;
+    void *mapping_              = nullptr;
+    journal_header *header_     = nullptr;
+    record_type *records_       = nullptr;
+    std::size_t capacity_       = 0;
+    std::size_t segment_count_  = 0;
+    u32 segment_index_          = 0;
+    u64 sequence_               = 0;
+
+    std::thread drain_thread_;
+    bool running_ = false;
+    bool ready_   = false;
+};
+
+/*
+ * Zero-copy cursor over the segments written by a journal_writer. Segments are mapped read only one at a time and
+ * next() returns pointers straight into the mapping, valid until the cursor moves to the following segment.
+ */
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class journal_reader
+{
+public:
+    using record_type = journal_record<T>;
+
+    journal_reader(std::filesystem::path directory, const std::string_view name) noexcept
+        : directory_(std::move(directory)), name_(name)
+    {
+        ready_ = open_segment(0);
+    }
+
+    ~journal_reader() noexcept
+    {
+        close_segment();
+    }
+
+    journal_reader(const journal_reader &)            = delete;
+    journal_reader &operator=(const journal_reader &) = delete;
+    journal_reader(journal_reader &&)                 = delete;
+    journal_reader &operator=(journal_reader &&)      = delete;
+
+    /**
+     * @brief false if the first segment is missing, was written for a different record type or its header does not
+     * fit the file.
+     */
+    [[nodiscard]] bool successful_init() const noexcept
+    {
+        return ready_;
+    }
+
+    /**
+     * @brief The committed records of the current segment, for callers that want to walk a whole segment at once.
+     */
+    [[nodiscard]] std::span<const record_type> segment() const noexcept
+    {
+        if (header_ == nullptr)
+        {
+            return {};
+        }
+        const u64 committed = std::atomic_ref(header_->count_).load(std::memory_order::acquire);
+        // the capacity was checked against the mapping on open, the count is re-read live so clamp it to that
+        return {records_, static_cast<std::size_t>(std::min(committed, header_->capacity_))};
+    }
+
+    /**
+     * @brief Returns the next record, or nullptr once every segment has been read.
+     */
+    [[nodiscard]] const record_type *next() noexcept
+    {
+        while (header_ != nullptr)
+        {
+            const std::size_t committed = segment().size();
+            if (position_ < committed)
+            {
+                return records_ + position_++;
+            }
+            // only move on from a segment the writer has filled, a partial one is the live tail
+            if (committed < header_->capacity_ || !open_segment(segment_index_ + 1))
+            {
+                return nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    bool open_segment(const u32 index) noexcept
+    {
+        std::filesystem::path path;
+        try
+        {
+            path = detail::segment_path(directory_, name_, index);
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(journal_header))
+        {
+            ::close(fd);
+            return false;
+        }
+        const auto bytes = static_cast<std::size_t>(info.st_size);
+        void *mapping    = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            return false;
+        }
+
+        // everything after this trusts the header, so a truncated or corrupt file must not get past here
+        auto *header = static_cast<journal_header *>(mapping);
+        if (header->magic_ != journal_header::magic || header->record_size_ != sizeof(record_type) ||
+            !records_fit(*header, bytes))
+        {
+            munmap(mapping, bytes);
+            return false;
+        }
+        madvise(mapping, bytes, MADV_SEQUENTIAL);
+
+        close_segment();
+        mapping_       = mapping;
+        mapping_bytes_ = bytes;
+        header_        = header;
+        records_       = reinterpret_cast<const record_type *>(static_cast<const std::byte *>(mapping) +
+                                                              header->records_offset_);
+        position_      = 0;
+        segment_index_ = index;
+        return true;
+    }
+
+    static bool records_fit(journal_header &header, const std::size_t bytes) noexcept
+    {
+        if (header.records_offset_ < sizeof(journal_header) || header.records_offset_ % alignof(record_type) != 0 ||
+            header.records_offset_ > bytes)
+        {
+            return false;
+        }
+        // divide rather than multiply so a garbage capacity can't overflow, count_ never exceeds capacity_
+        const u64 room = (bytes - header.records_offset_) / sizeof(record_type);
+        return header.capacity_ <= room &&
+               std::atomic_ref(header.count_).load(std::memory_order::acquire) <= header.capacity_;
+    }
+
+    void close_segment() noexcept
+    {
+        if (mapping_ != nullptr)
+        {
+            munmap(mapping_, mapping_bytes_);
+            mapping_ = nullptr;
+            header_  = nullptr;
+            records_ = nullptr;
+        }
+    }
+
+    std::filesystem::path directory_;
+    std::string name_;
+    void *mapping_              = nullptr;
+    std::size_t mapping_bytes_  = 0;
+    journal_header *header_     = nullptr;
+    const record_type *records_ = nullptr;
+    std::size_t position_       = 0;
+    u32 segment_index_          = 0;
+    bool ready_                 = false;
+};
+
+/**
+ * @brief Feeds journalled payloads back into a queue, pacing them by their original timestamps.
+ * @param speed replay speed relative to the recording, 1 is real time, 10 ten times faster and 0 as fast as the queue
+ * accepts them.
+ * @return the number of records replayed.
+ */
+template <typename T, typename Queue>
+u64 replay(journal_reader<T> &reader, Queue &queue, const double speed = 1.0) noexcept
+{
+    const journal_record<T> *record = reader.next();
+    if (record == nullptr)
+    {
+        return 0;
+    }
+
+    const u64 first_recorded = record->timestamp_ns_;
+    const u64 started        = detail::now_ns();
+    u64 count                = 0;
+    for (; record != nullptr; record = reader.next())
+    {
+        if (speed > 0)
+        {
+            const auto offset = static_cast<u64>(static_cast<double>(record->timestamp_ns_ - first_recorded) / speed);
+            while (detail::now_ns() - started < offset)
+            {
+            }
+        }
+        queue.put(T{record->payload_});
+        ++count;
+    }
+    return count;
+}
+
+} // namespace jc::io
+
+#endif
@@ -0,0 +1,440 @@
+#ifndef JC_LOGGER_H
+#define JC_LOGGER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <iterator>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <jc_collections/lockfree/byte_spsc.hpp>
+#include <jc_collections/lockfree/thread_pool.hpp>
+#include <jc_collections/util.h>
+
+namespace jc::io
+{
+
+/*
+ * String literal usable as a template argument, so every log call site gets its own instantiation and with it a
+ * static descriptor the background thread can format from.
+ */
+template <std::size_t n>
+struct fixed_string
+{
+    char data_[n]{};
+
+    constexpr fixed_string(const char (&text)[n]) noexcept
+    {
+        std::copy_n(text, n, data_);
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const noexcept
+    {
+        return {data_, n - 1};
+    }
+};
+
+enum class log_level : u8
+{
+    debug,
+    info,
+    warn,
+    error,
+};
+
+/*
+ * Arguments travel as raw bytes and are formatted later on another thread, so they have to be safe to memcpy and must
+ * not point at anything the caller might free or overwrite in the meantime.
+ */
+template <typename T>
+concept loggable = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !std::is_member_pointer_v<T>;
+
+namespace detail
+{
+/*
+ * What a call site's format id resolves to. The id written to the ring is the address of the site's descriptor.
+ */
+struct log_site
+{
+    std::string_view format_;
+    log_level level_;
+    void (*format_args_)(std::string &out, std::string_view format, const std::byte *args);
+};
+
+template <typename T>
+T load_arg(const std::byte *bytes) noexcept
+{
+    // arguments are packed without padding, so copy each one out to somewhere suitably aligned first
+    alignas(T) std::byte storage[sizeof(T)];
+    std::memcpy(storage, bytes, sizeof(T));
+    return *std::launder(reinterpret_cast<T *>(storage));
+}
+
+template <typename... Args, std::size_t... Is>
+void format_packed(std::string &out, const std::string_view format, const std::byte *args,
+                   std::index_sequence<Is...>)
+{
+    static constexpr std::array<std::size_t, sizeof...(Args) + 1> offsets = [] {
+        constexpr std::array<std::size_t, sizeof...(Args)> sizes{sizeof(Args)...};
+        std::array<std::size_t, sizeof...(Args) + 1> result{};
+        for (std::size_t i = 0; i < sizes.size(); i++)
+        {
+            result[i + 1] = result[i] + sizes[i];
+        }
+        return result;
+    }();
+
+    std::tuple<Args...> values{load_arg<Args>(args + offsets[Is])...};
+    std::apply(
+        [&](Args &...value) { std::vformat_to(std::back_inserter(out), format, std::make_format_args(value...)); },
+        values);
+}
+
+template <typename... Args>
+void format_packed(std::string &out, const std::string_view format, const std::byte *args)
+{
+    format_packed<Args...>(out, format, args, std::index_sequence_for<Args...>{});
+}
+
+template <fixed_string format, log_level level, typename... Args>
+struct site_for
+{
+    // rejects a format string that doesn't match the arguments at compile time, just like std::format would
+    static constexpr std::format_string<Args...> checked{format.view()};
+    static constexpr log_site site{format.view(), level, &format_packed<Args...>};
+};
+
+inline constexpr std::string_view level_names[] = {"DEBUG", "INFO ", "WARN ", "ERROR"};
+} // namespace detail
+
+/*
+ * Logger that keeps formatting and I/O off the calling thread. A log call copies the call site's id, a timestamp and
+ * the raw argument bytes into a byte_spsc ring owned by the calling thread; a background thread drains every ring,
+ * formats with std::format and writes the text to the file in large batches.
+ *
+ * Each thread gets its own ring the first time it logs, that one call allocates and every later one doesn't. Rings
+ * are kept until the logger is destroyed, so it is meant for a set of long lived threads. A full ring drops the
+ * message and counts it rather than block the caller. Lines from one thread stay in order, lines from different
+ * threads are interleaved batch by batch.
+ */
+template <std::size_t ring_bytes = 1 << 20>
+class async_logger
+{
+private:
+    struct producer
+    {
+        lockfree::byte_spsc<ring_bytes> ring_;
+        std::atomic<u64> dropped_ = 0;
+        std::thread::id owner_    = std::this_thread::get_id();
+        producer *next_           = nullptr;
+    };
+
+    struct message_header
+    {
+        const detail::log_site *site_;
+        i64 timestamp_ns_;
+    };
+
+public:
+    /**
+     * @brief Opens (appending to) the log file. It does not throw, call `successful_init()` to check the result.
+     */
+    explicit async_logger(const std::filesystem::path &file) noexcept
+    {
+        fd_ = ::open(file.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    }
+
+    ~async_logger() noexcept
+    {
+        stop();
+        producer *node = producers_.load(std::memory_order::acquire);
+        while (node != nullptr)
+        {
+            delete std::exchange(node, node->next_);
+        }
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+    }
+
+    async_logger(const async_logger &)            = delete;
+    async_logger &operator=(const async_logger &) = delete;
+    async_logger(async_logger &&)                 = delete;
+    async_logger &operator=(async_logger &&)      = delete;
+
+    [[nodiscard]] bool successful_init() const noexcept
+    {
+        return fd_ >= 0;
+    }
+
+    /**
+     * @brief Starts the background thread, pinned to `core` when it is not negative.
+     */
+    void start(const int core = -1)
+    {
+        if (running_ || fd_ < 0)
+        {
+            return;
+        }
+        stop_.store(false, std::memory_order::relaxed);
+        backend_ = std::thread([this, core] {
+            if (core >= 0)
+            {
+                lockfree::pin_current_thread(core);
+            }
+            run();
+        });
+        running_ = true;
+    }
+
+    /**
+     * @brief Formats and writes everything already logged, then joins the background thread.
+     */
+    void stop()
+    {
+        if (!running_)
+        {
+            return;
+        }
+        stop_.store(true, std::memory_order::release);
+        backend_.join();
+        running_ = false;
+    }
+
+    void set_level(const log_level level) noexcept
+    {
+        level_.store(level, std::memory_order::relaxed);
+    }
+
+    /**
+     * @brief Hot path: one ring reservation and a memcpy per argument.
+     * @return false if the message was filtered out or dropped.
+     */
+    template <fixed_string format, log_level level = log_level::info, loggable... Args>
+    bool log(const Args &...args) noexcept
+    {
+        if (level < level_.load(std::memory_order::relaxed))
+        {
+            return false;
+        }
+        producer *self = local_producer();
+        if (self == nullptr)
+        {
+            return false;
+        }
+
+        constexpr std::size_t bytes = sizeof(message_header) + (sizeof(Args) + ... + 0);
+        std::byte *frame            = self->ring_.try_reserve(bytes);
+        if (frame == nullptr)
+        {
+            self->dropped_.store(self->dropped_.load(std::memory_order::relaxed) + 1, std::memory_order::relaxed);
+            return false;
+        }
+
+        const message_header header{&detail::site_for<format, level, Args...>::site,
+                                    std::chrono::system_clock::now().time_since_epoch().count()};
+        std::memcpy(frame, &header, sizeof(header));
+        frame += sizeof(header);
+        ((std::memcpy(frame, &args, sizeof(Args)), frame += sizeof(Args)), ...);
+        self->ring_.commit();
+        return true;
+    }
+
+    template <fixed_string format, loggable... Args>
+    bool debug(const Args &...args) noexcept
+    {
+        return log<format, log_level::debug>(args...);
+    }
+
+    template <fixed_string format, loggable... Args>
+    bool info(const Args &...args) noexcept
+    {
+        return log<format, log_level::info>(args...);
+    }
+
+    template <fixed_string format, loggable... Args>
+    bool warn(const Args &...args) noexcept
+    {
+        return log<format, log_level::warn>(args...);
+    }
+
+    template <fixed_string format, loggable... Args>
+    bool error(const Args &...args) noexcept
+    {
+        return log<format, log_level::error>(args...);
+    }
+
+    [[nodiscard]] u64 written() const noexcept
+    {
+        return written_.load(std::memory_order::relaxed);
+    }
+
+    [[nodiscard]] u64 dropped() const noexcept
+    {
+        u64 total = 0;
+        for (producer *node = producers_.load(std::memory_order::acquire); node != nullptr; node = node->next_)
+        {
+            total += node->dropped_.load(std::memory_order::relaxed);
+        }
+        return total;
+    }
+
+private:
+    static constexpr std::size_t flush_bytes = 64 * 1024;
+    static constexpr std::size_t spin_limit  = 1024;
+    static constexpr auto idle_sleep         = std::chrono::microseconds(50);
+
+    producer *local_producer() noexcept
+    {
+        // the ring of the logger this thread wrote to last. The cache is keyed by the logger's id: a logger created at
+        // a destroyed one's address must not write into that logger's freed ring
+        thread_local u64 cached_logger     = 0;
+        thread_local producer *cached_ring = nullptr;
+        if (cached_logger != id_)
+        {
+            cached_ring   = claim_ring();
+            cached_logger = cached_ring == nullptr ? 0 : id_;
+        }
+        return cached_ring;
+    }
+
+    /*
+     * the cache only remembers one logger, so a thread writing to two in turn lands here on every switch. Its ring in
+     * this logger is picked out of the list by thread id, a new ring is only pushed the first time it logs here.
+     */
+    producer *claim_ring() noexcept
+    {
+        const std::thread::id self = std::this_thread::get_id();
+        producer *head             = producers_.load(std::memory_order::acquire);
+        for (producer *ring = head; ring != nullptr; ring = ring->next_)
+        {
+            if (ring->owner_ == self)
+            {
+                return ring;
+            }
+        }
+
+        auto *ring = new (std::nothrow) producer;
+        if (ring == nullptr)
+        {
+            return nullptr;
+        }
+        do
+        {
+            ring->next_ = head;
+        } while (!producers_.compare_exchange_weak(head, ring, std::memory_order::release, std::memory_order::relaxed));
+        return ring;
+    }
+
+    void run()
+    {
+        std::string text;
+        text.reserve(flush_bytes * 2);
+        std::size_t idle = 0;
+        while (true)
+        {
+            // read the flag first so the pass after it sees everything logged before stop()
+            const bool stopping = stop_.load(std::memory_order::acquire);
+            std::size_t count   = 0;
+            for (producer *node = producers_.load(std::memory_order::acquire); node != nullptr; node = node->next_)
+            {
+                count += drain(node->ring_, text);
+            }
+            if (!text.empty() && (count == 0 || text.size() >= flush_bytes))
+            {
+                write_out(text);
+            }
+            if (count > 0)
+            {
+                idle = 0;
+                continue;
+            }
+            if (stopping)
+            {
+                return;
+            }
+            if (++idle > spin_limit)
+            {
+                std::this_thread::sleep_for(idle_sleep);
+            }
+        }
+    }
+
+    std::size_t drain(lockfree::byte_spsc<ring_bytes> &ring, std::string &text)
+    {
+        std::size_t count = 0;
+        for (std::span<const std::byte> message = ring.try_read(); !message.empty(); message = ring.try_read())
+        {
+            message_header header;
+            std::memcpy(&header, message.data(), sizeof(header));
+
+            const std::chrono::sys_time<std::chrono::microseconds> time = std::chrono::floor<std::chrono::microseconds>(
+                std::chrono::sys_time<std::chrono::system_clock::duration>(
+                    std::chrono::system_clock::duration(header.timestamp_ns_)));
+            std::format_to(std::back_inserter(text), "{:%F %T} {} ", time,
+                           detail::level_names[static_cast<std::size_t>(header.site_->level_)]);
+            header.site_->format_args_(text, header.site_->format_, message.data() + sizeof(header));
+            text.push_back('\n');
+
+            ring.release();
+            ++count;
+            if (text.size() >= flush_bytes)
+            {
+                write_out(text);
+            }
+        }
+        written_.store(written_.load(std::memory_order::relaxed) + count, std::memory_order::relaxed);
+        return count;
+    }
+
+    void write_out(std::string &text) noexcept
+    {
+        std::size_t offset = 0;
+        while (offset < text.size())
+        {
+            const ssize_t result = ::write(fd_, text.data() + offset, text.size() - offset);
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                break;
+            }
+            offset += static_cast<std::size_t>(result);
+        }
+        text.clear();
+    }
+
+    alignas(std::hardware_destructive_interference_size) std::atomic<producer *> producers_ = nullptr;
+    std::atomic<log_level> level_ = log_level::info;
+    alignas(std::hardware_destructive_interference_size) std::atomic<u64> written_ = 0;
+    std::atomic<bool> stop_ = false;
+
+    inline static std::atomic<u64> next_id_ = 1;
+    const u64 id_ = next_id_.fetch_add(1, std::memory_order::relaxed);
+
+    int fd_ = -1;
+    std::thread backend_;
+    bool running_ = false;
+};
+
+} // namespace jc::io
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef JC_BYTE_SPSC_H
+#define JC_BYTE_SPSC_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+
+#include <jc_collections/lockfree/spsc.hpp>
+
+namespace jc::lockfree
+{
+
+/*
+ * Single producer single consumer ring of variable length messages. Every message is a frame of an 8 byte length
+ * header followed by the payload rounded up to 8 bytes, and frames never straddle the end of the buffer: when the tail
+ * is too short the producer leaves a wrap marker there and starts the frame at the beginning.
+ *
+ * Both sides work in place, the producer reserves a frame, fills it and commits, the consumer peeks at a frame and
+ * releases it when done, so nothing is copied through the ring besides what the producer writes.
+ */
+template <std::size_t capacity = 1 << 16>
+    requires is_power_of_two<capacity> && (capacity >= 64)
+class byte_spsc
+{
+private:
+    static constexpr std::size_t mask        = capacity - 1;
+    static constexpr std::size_t header_size = sizeof(std::uint64_t);
+    static constexpr std::uint64_t wrap      = ~std::uint64_t{0};
+
+    struct aligned_indexes
+    {
+        std::atomic<std::size_t> idx_ = 0;
+        std::size_t cached_idx_       = 0;
+        // the frame handed out by reserve()/read() but not yet committed/released
+        std::size_t pending_ = 0;
+    };
+
+    alignas(std::hardware_destructive_interference_size) aligned_indexes writer_;
+    alignas(std::hardware_destructive_interference_size) aligned_indexes reader_;
+    alignas(std::hardware_destructive_interference_size) std::byte buffer_[capacity];
+
+    static constexpr std::size_t frame_size(const std::size_t bytes) noexcept
+    {
+        return header_size + ((bytes + header_size - 1) & ~(header_size - 1));
+    }
+
+public:
+    byte_spsc() = default;
+
+    byte_spsc(const byte_spsc &)            = delete;
+    byte_spsc &operator=(const byte_spsc &) = delete;
+    byte_spsc(byte_spsc &&)                 = delete;
+    byte_spsc &operator=(byte_spsc &&)      = delete;
+
+    /*
+     * largest payload a single message can carry.
+     */
+    static constexpr std::size_t max_message = capacity / 2 - header_size;
+
+    /*
+     * returns space for a `bytes` long message, or nullptr if the ring is too full. Nothing is visible to the consumer
+     * until commit(). Empty messages are refused, try_read() could not tell them apart from an empty ring.
+     */
+    [[nodiscard]] std::byte *try_reserve(const std::size_t bytes) noexcept
+    {
+        if (bytes == 0 || bytes > max_message)
+        {
+            return nullptr;
+        }
+        const std::size_t frame      = frame_size(bytes);
+        const std::size_t idx        = writer_.idx_.load(std::memory_order::relaxed);
+        const std::size_t contiguous = capacity - (idx & mask);
+        // a frame that doesn't fit before the end also uses up the tail it skips
+        const std::size_t needed = frame <= contiguous ? frame : contiguous + frame;
+
+        if (capacity - (idx - writer_.cached_idx_) < needed)
+        {
+            writer_.cached_idx_ = reader_.idx_.load(std::memory_order::acquire);
+            if (capacity - (idx - writer_.cached_idx_) < needed)
+            {
+                return nullptr;
+            }
+        }
+
+        std::size_t start = idx;
+        if (frame > contiguous)
+        {
+            std::memcpy(&buffer_[idx & mask], &wrap, header_size);
+            start += contiguous;
+        }
+        const std::uint64_t length = bytes;
+        std::memcpy(&buffer_[start & mask], &length, header_size);
+        writer_.pending_ = start + frame;
+        return &buffer_[(start & mask) + header_size];
+    }
+
+    /*
+     * publishes the message handed out by the last try_reserve().
+     */
+    void commit() noexcept
+    {
+        writer_.idx_.store(writer_.pending_, std::memory_order::release);
+    }
+
+    /*
+     * returns the oldest message without consuming it, or an empty span if there is none.
+     */
+    [[nodiscard]] std::span<const std::byte> try_read() noexcept
+    {
+        std::size_t idx = reader_.idx_.load(std::memory_order::relaxed);
+        if (idx == reader_.cached_idx_)
+        {
+            reader_.cached_idx_ = writer_.idx_.load(std::memory_order::acquire);
+            if (idx == reader_.cached_idx_)
+            {
+                return {};
+            }
+        }
+
+        std::uint64_t length;
+        std::memcpy(&length, &buffer_[idx & mask], header_size);
+        if (length == wrap)
+        {
+            // a marker is always committed together with the frame behind it
+            idx += capacity - (idx & mask);
+            std::memcpy(&length, &buffer_[idx & mask], header_size);
+        }
+        reader_.pending_ = idx + frame_size(length);
+        return {&buffer_[(idx & mask) + header_size], static_cast<std::size_t>(length)};
+    }
+
+    /*
+     * consumes the message returned by the last try_read().
+     */
+    void release() noexcept
+    {
+        reader_.idx_.store(reader_.pending_, std::memory_order::release);
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return reader_.idx_.load(std::memory_order::relaxed) == writer_.idx_.load(std::memory_order::acquire);
+    }
+};
+
+} // namespace jc::lockfree
+
+#endif
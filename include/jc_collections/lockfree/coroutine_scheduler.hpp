@@ -0,0 +1,350 @@
+#ifndef JC_COROUTINE_SCHEDULER_H
+#define JC_COROUTINE_SCHEDULER_H
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace jc::lockfree
+{
+
+/*
+ * Coroutine frames are allocated from the memory resource installed on the creating thread, which defaults to
+ * std::pmr::get_default_resource(). Install a base_allocator with frame_resource_scope so a burst of coroutines costs a
+ * bump each instead of a trip through malloc.
+ */
+inline std::pmr::memory_resource *&current_frame_resource() noexcept
+{
+    thread_local std::pmr::memory_resource *resource = std::pmr::get_default_resource();
+    return resource;
+}
+
+class frame_resource_scope
+{
+public:
+    explicit frame_resource_scope(std::pmr::memory_resource &resource) noexcept
+        : previous_(std::exchange(current_frame_resource(), &resource))
+    {
+    }
+
+    ~frame_resource_scope() noexcept
+    {
+        current_frame_resource() = previous_;
+    }
+
+    frame_resource_scope(const frame_resource_scope &)            = delete;
+    frame_resource_scope &operator=(const frame_resource_scope &) = delete;
+    frame_resource_scope(frame_resource_scope &&)                 = delete;
+    frame_resource_scope &operator=(frame_resource_scope &&)      = delete;
+
+private:
+    std::pmr::memory_resource *previous_;
+};
+
+/*
+ * Intrusive link used to hand a suspended coroutine to a scheduler. Nodes live in the coroutine frame, so waking a
+ * coroutine never allocates.
+ */
+struct schedule_node
+{
+    schedule_node *next_ = nullptr;
+    std::coroutine_handle<> handle_;
+};
+
+class coroutine_scheduler;
+
+/*
+ * Fire-and-forget coroutine driven by a coroutine_scheduler. It starts suspended, runs once spawned and frees its own
+ * frame when it finishes. If the frame can't be allocated the task comes back empty and spawn() refuses it.
+ * Exceptions are not supported and terminate.
+ */
+class co_task
+{
+public:
+    struct promise_type
+    {
+        coroutine_scheduler *scheduler_ = nullptr;
+        // a coroutine is queued at most once at a time, so its promise carries the link
+        schedule_node node_;
+
+        co_task get_return_object() noexcept
+        {
+            return co_task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        static co_task get_return_object_on_allocation_failure() noexcept
+        {
+            return co_task(nullptr);
+        }
+
+        /*
+         * hands this coroutine back to its scheduler, callable from any thread.
+         */
+        void wake() noexcept;
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        struct final_awaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+
+            void await_resume() const noexcept
+            {
+            }
+        };
+
+        final_awaiter final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept
+        {
+        }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+
+        // the resource is stashed in front of the frame so delete can find it without any thread local lookups
+        static constexpr std::size_t header_size = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+        static void *operator new(const std::size_t bytes) noexcept
+        {
+            std::pmr::memory_resource *resource = current_frame_resource();
+            void *raw                           = nullptr;
+            try
+            {
+                raw = resource->allocate(bytes + header_size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+            }
+            catch (...)
+            {
+                return nullptr;
+            }
+            if (raw == nullptr)
+            {
+                return nullptr;
+            }
+            *static_cast<std::pmr::memory_resource **>(raw) = resource;
+            return static_cast<std::byte *>(raw) + header_size;
+        }
+
+        static void operator delete(void *frame, const std::size_t bytes) noexcept
+        {
+            void *raw = static_cast<std::byte *>(frame) - header_size;
+            std::pmr::memory_resource *resource = *static_cast<std::pmr::memory_resource **>(raw);
+            resource->deallocate(raw, bytes + header_size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        }
+    };
+
+    [[nodiscard]] bool valid() const noexcept
+    {
+        return static_cast<bool>(handle_);
+    }
+
+    co_task(co_task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr))
+    {
+    }
+
+    co_task &operator=(co_task &&)      = delete;
+    co_task(const co_task &)            = delete;
+    co_task &operator=(const co_task &) = delete;
+
+    ~co_task()
+    {
+        // never spawned, the frame is still ours to free
+        if (handle_)
+        {
+            handle_.destroy();
+        }
+    }
+
+private:
+    friend class coroutine_scheduler;
+
+    explicit co_task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle)
+    {
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/*
+ * Minimal single threaded run loop for co_tasks. Coroutines on the scheduler's own thread are queued locally, wakeups
+ * from other threads land on a lock-free intrusive stack that the run loop drains when the local queue is empty. An
+ * idle scheduler spins on that stack instead of sleeping so a cross thread wakeup costs one cache line transfer.
+ *
+ * A wake() counts as local when it comes from inside run_one() on this scheduler, which is where every same thread
+ * wakeup happens in practice. Anything else goes through the remote stack, which is always safe.
+ */
+class coroutine_scheduler
+{
+public:
+    coroutine_scheduler() = default;
+
+    coroutine_scheduler(const coroutine_scheduler &)            = delete;
+    coroutine_scheduler &operator=(const coroutine_scheduler &) = delete;
+    coroutine_scheduler(coroutine_scheduler &&)                 = delete;
+    coroutine_scheduler &operator=(coroutine_scheduler &&)      = delete;
+
+    /*
+     * takes ownership of the task and queues it, must be called from the scheduler's thread. Returns false for a task
+     * whose frame could not be allocated.
+     */
+    bool spawn(co_task &&task) noexcept
+    {
+        if (!task.valid())
+        {
+            return false;
+        }
+        std::coroutine_handle<co_task::promise_type> handle = std::exchange(task.handle_, nullptr);
+        co_task::promise_type &promise                      = handle.promise();
+        promise.scheduler_                                  = this;
+        promise.node_.handle_                               = handle;
+        ++live_;
+        push_local(&promise.node_);
+        return true;
+    }
+
+    /*
+     * queue a suspended coroutine, callable from any thread. The node must stay alive until the coroutine resumes.
+     */
+    void post(schedule_node *node) noexcept
+    {
+        schedule_node *head = remote_.load(std::memory_order::relaxed);
+        do
+        {
+            node->next_ = head;
+        } while (!remote_.compare_exchange_weak(head, node, std::memory_order::release, std::memory_order::relaxed));
+    }
+
+    /*
+     * resumes one ready coroutine, returns false if nothing was ready.
+     */
+    bool run_one() noexcept
+    {
+        if (local_head_ == nullptr && !take_remote())
+        {
+            return false;
+        }
+
+        schedule_node *node = local_head_;
+        local_head_         = node->next_;
+        if (local_head_ == nullptr)
+        {
+            local_tail_ = nullptr;
+        }
+        // restored afterwards so a scheduler driven from inside another one's coroutine doesn't clobber it
+        coroutine_scheduler *outer = std::exchange(running(), this);
+        node->handle_.resume();
+        running() = outer;
+        return true;
+    }
+
+    /*
+     * runs until every spawned task has finished.
+     */
+    void run() noexcept
+    {
+        while (live_ > 0)
+        {
+            run_one();
+        }
+    }
+
+    [[nodiscard]] std::size_t live() const noexcept
+    {
+        return live_;
+    }
+
+private:
+    friend struct co_task::promise_type;
+    friend struct co_task::promise_type::final_awaiter;
+
+    static coroutine_scheduler *&running() noexcept
+    {
+        thread_local coroutine_scheduler *scheduler = nullptr;
+        return scheduler;
+    }
+
+    void push_local(schedule_node *node) noexcept
+    {
+        node->next_ = nullptr;
+        if (local_tail_ == nullptr)
+        {
+            local_head_ = node;
+        }
+        else
+        {
+            local_tail_->next_ = node;
+        }
+        local_tail_ = node;
+    }
+
+    bool take_remote() noexcept
+    {
+        schedule_node *stack = remote_.exchange(nullptr, std::memory_order::acquire);
+        if (stack == nullptr)
+        {
+            return false;
+        }
+
+        // the stack is LIFO, reverse it so coroutines resume in the order they were posted
+        schedule_node *reversed = nullptr;
+        while (stack != nullptr)
+        {
+            schedule_node *next = stack->next_;
+            stack->next_        = reversed;
+            reversed            = stack;
+            stack               = next;
+        }
+        while (reversed != nullptr)
+        {
+            schedule_node *next = reversed->next_;
+            push_local(reversed);
+            reversed = next;
+        }
+        return true;
+    }
+
+    alignas(std::hardware_destructive_interference_size) std::atomic<schedule_node *> remote_ = nullptr;
+    alignas(std::hardware_destructive_interference_size) schedule_node *local_head_ = nullptr;
+    schedule_node *local_tail_ = nullptr;
+    std::size_t live_          = 0;
+};
+
+inline void co_task::promise_type::wake() noexcept
+{
+    if (coroutine_scheduler::running() == scheduler_)
+    {
+        scheduler_->push_local(&node_);
+    }
+    else
+    {
+        scheduler_->post(&node_);
+    }
+}
+
+inline void co_task::promise_type::final_awaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+{
+    coroutine_scheduler *scheduler = handle.promise().scheduler_;
+    handle.destroy();
+    --scheduler->live_;
+}
+
+} // namespace jc::lockfree
+
+#endif
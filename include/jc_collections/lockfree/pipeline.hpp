@@ -0,0 +1,262 @@
+#ifndef JC_PIPELINE_H
+#define JC_PIPELINE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <jc_collections/lockfree/spsc.hpp>
+#include <jc_collections/lockfree/thread_pool.hpp>
+
+namespace jc::lockfree
+{
+
+/*
+ * A pipeline stage declares what it consumes and produces and transforms one element at a time. Returning false
+ * drops the element, which lets a stage filter.
+ */
+template <typename S>
+concept pipeline_stage = requires(S stage, typename S::input_type &in, typename S::output_type &out) {
+    { stage(in, out) } -> std::convertible_to<bool>;
+};
+
+/*
+ * Snapshot of a stage's accounting, a poll is busy when it found at least one element.
+ */
+struct stage_stats
+{
+    std::uint64_t items_      = 0;
+    std::uint64_t busy_polls_ = 0;
+    std::uint64_t idle_polls_ = 0;
+    std::uint64_t busy_ns_    = 0;
+};
+
+/*
+ * Compile-time chain of stages, each running on its own thread and connected to the next by a cached_spsc ring. The
+ * pipeline owns one ring in front of the first stage (input()) and one after the last (output()), so a topology is
+ * just a list of types and the glue is generated.
+ *
+ * Each stage thread drains up to `batch_size` elements per poll and only then checks the stop flag and updates its
+ * counters, so the accounting costs two clock reads per batch rather than per element. A full downstream ring makes
+ * the stage spin, so back pressure propagates up to input(). A stage stopped while spinning drops that one element.
+ *
+ * Note: input() has a single producer and output() a single consumer, like every other SPSC ring in the library.
+ */
+template <std::size_t ring_size, std::size_t batch_size, pipeline_stage... Stages>
+    requires(sizeof...(Stages) > 0) && (batch_size > 0)
+class pipeline
+{
+private:
+    static constexpr std::size_t stage_count = sizeof...(Stages);
+
+    template <std::size_t I>
+    using stage_type = std::tuple_element_t<I, std::tuple<Stages...>>;
+
+    using input_type  = typename stage_type<0>::input_type;
+    using output_type = typename stage_type<stage_count - 1>::output_type;
+
+    template <std::size_t... Is>
+    static constexpr bool stages_connect(std::index_sequence<Is...>)
+    {
+        return (std::is_same_v<typename stage_type<Is>::output_type, typename stage_type<Is + 1>::input_type> && ...);
+    }
+    static_assert(stages_connect(std::make_index_sequence<stage_count - 1>{}),
+                  "each stage's output_type must be the next stage's input_type");
+
+    // ring I feeds stage I, the extra ring at the end collects the last stage's output
+    using rings_type = std::tuple<cached_spsc<typename Stages::input_type, ring_size>...,
+                                  cached_spsc<output_type, ring_size>>;
+
+    struct alignas(std::hardware_destructive_interference_size) stage_counters
+    {
+        std::atomic<std::uint64_t> items_      = 0;
+        std::atomic<std::uint64_t> busy_polls_ = 0;
+        std::atomic<std::uint64_t> idle_polls_ = 0;
+        std::atomic<std::uint64_t> busy_ns_    = 0;
+    };
+
+public:
+    using input_ring  = std::tuple_element_t<0, rings_type>;
+    using output_ring = std::tuple_element_t<stage_count, rings_type>;
+
+    pipeline() noexcept(std::is_nothrow_default_constructible_v<std::tuple<Stages...>>)
+        requires(std::is_default_constructible_v<Stages> && ...)
+    = default;
+
+    explicit pipeline(Stages... stages) noexcept(std::is_nothrow_move_constructible_v<std::tuple<Stages...>>)
+        : stages_(std::move(stages)...)
+    {
+    }
+
+    ~pipeline()
+    {
+        stop();
+    }
+
+    pipeline(const pipeline &)            = delete;
+    pipeline &operator=(const pipeline &) = delete;
+    pipeline(pipeline &&)                 = delete;
+    pipeline &operator=(pipeline &&)      = delete;
+
+    /**
+     * @brief Launches one thread per stage, stage i is pinned to cores[i] when the span is long enough.
+     * @return false if a thread could not be created, the stages already launched are then stopped again.
+     */
+    bool start(std::span<const int> cores = {}) noexcept
+    {
+        if (running_)
+        {
+            return true;
+        }
+        stop_.store(false, std::memory_order::relaxed);
+        running_ = true;
+        try
+        {
+            launch(cores, std::make_index_sequence<stage_count>{});
+        }
+        catch (...)
+        {
+            stop();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Stops every stage after its current batch and joins the threads. Elements still in the rings stay there.
+     */
+    void stop()
+    {
+        if (!running_)
+        {
+            return;
+        }
+        stop_.store(true, std::memory_order::relaxed);
+        // after a failed start only some of the threads exist
+        for (std::thread &thread : threads_)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+        running_ = false;
+    }
+
+    [[nodiscard]] input_ring &input() noexcept
+    {
+        return std::get<0>(rings_);
+    }
+
+    [[nodiscard]] output_ring &output() noexcept
+    {
+        return std::get<stage_count>(rings_);
+    }
+
+    [[nodiscard]] static constexpr std::size_t size() noexcept
+    {
+        return stage_count;
+    }
+
+    [[nodiscard]] stage_stats stats(const std::size_t stage) const noexcept
+    {
+        const stage_counters &counters = counters_[stage];
+        return stage_stats{counters.items_.load(std::memory_order::relaxed),
+                           counters.busy_polls_.load(std::memory_order::relaxed),
+                           counters.idle_polls_.load(std::memory_order::relaxed),
+                           counters.busy_ns_.load(std::memory_order::relaxed)};
+    }
+
+private:
+    template <std::size_t... Is>
+    void launch(std::span<const int> cores, std::index_sequence<Is...>)
+    {
+        ((threads_[Is] = std::thread([this, core = Is < cores.size() ? cores[Is] : -1] {
+              if (core >= 0)
+              {
+                  pin_current_thread(core);
+              }
+              run_stage<Is>();
+          })),
+         ...);
+    }
+
+    template <std::size_t I>
+    void run_stage()
+    {
+        auto &stage    = std::get<I>(stages_);
+        auto &in       = std::get<I>(rings_);
+        auto &out      = std::get<I + 1>(rings_);
+        auto &counters = counters_[I];
+
+        // counters are only written by this thread, so plain locals are published once per batch
+        std::uint64_t items      = 0;
+        std::uint64_t busy_polls = 0;
+        std::uint64_t idle_polls = 0;
+        std::uint64_t busy_ns    = 0;
+
+        typename stage_type<I>::output_type result{};
+        while (!stop_.load(std::memory_order::relaxed))
+        {
+            std::optional<typename stage_type<I>::input_type> element = in.try_read();
+            if (!element)
+            {
+                counters.idle_polls_.store(++idle_polls, std::memory_order::relaxed);
+                continue;
+            }
+
+            const auto start  = std::chrono::steady_clock::now();
+            std::size_t count = 0;
+            do
+            {
+                if (stage(*element, result) && !forward(out, result))
+                {
+                    return;
+                }
+                ++count;
+            } while (count < batch_size && (element = in.try_read()));
+            const auto stop = std::chrono::steady_clock::now();
+
+            items += count;
+            busy_ns += static_cast<std::uint64_t>(std::chrono::nanoseconds(stop - start).count());
+            counters.items_.store(items, std::memory_order::relaxed);
+            counters.busy_polls_.store(++busy_polls, std::memory_order::relaxed);
+            counters.busy_ns_.store(busy_ns, std::memory_order::relaxed);
+        }
+    }
+
+    template <typename Ring, typename U>
+    bool forward(Ring &out, U &element) noexcept
+    {
+        // try_put only consumes the element on success, so it is safe to retry with it
+        while (!out.try_put(std::move(element)))
+        {
+            if (stop_.load(std::memory_order::relaxed))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::tuple<Stages...> stages_;
+    rings_type rings_;
+    std::array<stage_counters, stage_count> counters_{};
+    std::array<std::thread, stage_count> threads_{};
+    alignas(std::hardware_destructive_interference_size) std::atomic<bool> stop_ = false;
+    bool running_ = false;
+};
+
+} // namespace jc::lockfree
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef JC_PRIORITY_SPSC_H
+#define JC_PRIORITY_SPSC_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <jc_collections/lockfree/spsc.hpp>
+#include <jc_collections/util.h>
+
+namespace jc::lockfree
+{
+
+/*
+ * Bundle of `lanes` cached_spsc rings between one producer and one consumer, lane 0 being the most urgent. Every
+ * lane is FIFO on its own, but the consumer always serves the most urgent lane that has something in it, so a cancel
+ * overtakes a backlog of new orders instead of queueing behind it.
+ *
+ * Which lanes have elements is kept in a single word bitmask, the same layout scalar_bitset uses, so picking the
+ * lane is a countr_zero. The mask is only a hint the consumer keeps honest: the producer sets a lane's bit after
+ * publishing into it and the consumer clears it when it finds the lane drained, then looks once more in case the
+ * producer refilled the lane in between. Both updates are read-modify-writes on the one word, so whichever comes
+ * second sees the other and no element is ever left behind an unset bit.
+ */
+template <typename T, std::size_t lanes = 2, std::size_t lane_size = 512>
+    requires(lanes > 0) && (lanes <= 64)
+class priority_spsc
+{
+private:
+    using lane_type = cached_spsc<T, lane_size>;
+
+    alignas(std::hardware_destructive_interference_size) std::atomic<u64> ready_ = 0;
+    std::array<lane_type, lanes> lanes_;
+
+    void mark_ready(const std::size_t lane) noexcept
+    {
+        ready_.fetch_or(u64{1} << lane, std::memory_order::release);
+    }
+
+    std::optional<T> take(u64 mask, std::size_t *lane_out) noexcept
+    {
+        while (mask != 0)
+        {
+            const auto lane = static_cast<std::size_t>(std::countr_zero(mask));
+            const u64 bit   = u64{1} << lane;
+            if (std::optional<T> element = lanes_[lane].try_read())
+            {
+                if (lane_out != nullptr)
+                {
+                    *lane_out = lane;
+                }
+                return element;
+            }
+
+            // acquire pairs with the producer's fetch_or, so the second look sees anything published before it
+            ready_.fetch_and(~bit, std::memory_order::acq_rel);
+            if (std::optional<T> element = lanes_[lane].try_read())
+            {
+                // refilled while we were clearing, put the bit back so the rest isn't forgotten
+                ready_.fetch_or(bit, std::memory_order::relaxed);
+                if (lane_out != nullptr)
+                {
+                    *lane_out = lane;
+                }
+                return element;
+            }
+            mask &= ~bit;
+        }
+        return {};
+    }
+
+public:
+    priority_spsc() = default;
+
+    priority_spsc(const priority_spsc &)            = delete;
+    priority_spsc &operator=(const priority_spsc &) = delete;
+    priority_spsc(priority_spsc &&)                 = delete;
+    priority_spsc &operator=(priority_spsc &&)      = delete;
+
+    static constexpr std::size_t lane_count = lanes;
+
+    /*
+     * returns false if the lane is full, other lanes are unaffected.
+     */
+    bool try_put(const std::size_t lane, T &&element) noexcept
+    {
+        if (!lanes_[lane].try_put(std::move(element)))
+        {
+            return false;
+        }
+        mark_ready(lane);
+        return true;
+    }
+
+    /*
+     * spin here and busy wait until the lane has room.
+     */
+    void put(const std::size_t lane, T &&element) noexcept
+    {
+        lanes_[lane].put(std::move(element));
+        mark_ready(lane);
+    }
+
+    template <typename... Args>
+    void emplace(const std::size_t lane, Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args &&...>)
+    {
+        lanes_[lane].emplace(std::forward<Args>(args)...);
+        mark_ready(lane);
+    }
+
+    /*
+     * the oldest element of the most urgent non-empty lane.
+     */
+    std::optional<T> try_read() noexcept
+    {
+        return take(ready_.load(std::memory_order::acquire), nullptr);
+    }
+
+    /*
+     * same as try_read(), also reporting which lane the element came from.
+     */
+    std::optional<T> try_read(std::size_t &lane) noexcept
+    {
+        return take(ready_.load(std::memory_order::acquire), &lane);
+    }
+
+    /*
+     * spin here and busy wait to remove latency.
+     */
+    [[nodiscard]] T read() noexcept
+    {
+        while (true)
+        {
+            if (std::optional<T> element = try_read())
+            {
+                return std::move(*element);
+            }
+        }
+    }
+
+    /*
+     * lanes the producer has marked as having elements, a snapshot for monitoring.
+     */
+    [[nodiscard]] u64 ready_lanes() const noexcept
+    {
+        return ready_.load(std::memory_order::relaxed);
+    }
+};
+
+} // namespace jc::lockfree
+
+#endif
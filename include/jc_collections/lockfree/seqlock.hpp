@@ -0,0 +1,180 @@
+#ifndef JC_SEQLOCK_H
+#define JC_SEQLOCK_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace jc::lockfree
+{
+
+/*
+ * Single writer, many reader publication cell. The writer never blocks, readers take a consistent copy of the last
+ * published value and retry if a write raced with their copy. An odd sequence number means a write is in progress.
+ *
+ * The payload copy is a plain memcpy which races with the writer by design; torn copies are detected by the sequence
+ * check and thrown away, which is why T must be trivially copyable.
+ */
+template <typename T>
+    requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+class seqlock
+{
+private:
+    alignas(std::hardware_destructive_interference_size) std::atomic<std::size_t> seq_ = 0;
+    T value_{};
+
+public:
+    seqlock() = default;
+
+    explicit seqlock(const T &initial) noexcept : value_(initial)
+    {
+    }
+
+    seqlock(const seqlock &)            = delete;
+    seqlock &operator=(const seqlock &) = delete;
+    seqlock(seqlock &&)                 = delete;
+    seqlock &operator=(seqlock &&)      = delete;
+
+    /*
+     * only one thread may call store.
+     */
+    void store(const T &value) noexcept
+    {
+        const std::size_t seq = seq_.load(std::memory_order::relaxed);
+        seq_.store(seq + 1, std::memory_order::relaxed);
+        std::atomic_thread_fence(std::memory_order::release);
+
+        std::memcpy(&value_, &value, sizeof(T));
+
+        seq_.store(seq + 2, std::memory_order::release);
+    }
+
+    /*
+     * single attempt at a copy, returns false if a write was in progress or raced with the copy.
+     */
+    bool try_load(T &out) const noexcept
+    {
+        const std::size_t before = seq_.load(std::memory_order::acquire);
+        if (before & 1)
+        {
+            return false;
+        }
+
+        std::memcpy(&out, &value_, sizeof(T));
+        std::atomic_thread_fence(std::memory_order::acquire);
+
+        return before == seq_.load(std::memory_order::relaxed);
+    }
+
+    /*
+     * spin until a consistent copy is taken.
+     */
+    [[nodiscard]] T load() const noexcept
+    {
+        T result;
+        while (!try_load(result))
+        {
+        }
+        return result;
+    }
+
+    /*
+     * number of completed writes, useful for readers to tell whether anything changed since their last copy.
+     */
+    [[nodiscard]] std::size_t version() const noexcept
+    {
+        return seq_.load(std::memory_order::acquire) >> 1;
+    }
+};
+
+/*
+ * Multi slot variant of the seqlock. The writer rotates over `slots` cells, each guarded by its own sequence number,
+ * and publishes the index of the newest complete slot. A reader only has to retry if the writer lapped the whole ring
+ * while it was copying, so under heavy write rates readers almost never retry and never contend on the line being
+ * written.
+ */
+template <typename T, std::size_t slots = 4>
+    requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> && (std::has_single_bit(slots))
+class versioned_seqlock
+{
+private:
+    static constexpr std::size_t mask = slots - 1;
+
+    struct alignas(std::hardware_destructive_interference_size) slot
+    {
+        std::atomic<std::size_t> seq_ = 0;
+        T value_{};
+    };
+
+    alignas(std::hardware_destructive_interference_size) std::atomic<std::size_t> version_ = 0;
+    std::array<slot, slots> slots_;
+
+public:
+    versioned_seqlock() = default;
+
+    explicit versioned_seqlock(const T &initial) noexcept
+    {
+        slots_[0].value_ = initial;
+    }
+
+    versioned_seqlock(const versioned_seqlock &)            = delete;
+    versioned_seqlock &operator=(const versioned_seqlock &) = delete;
+    versioned_seqlock(versioned_seqlock &&)                 = delete;
+    versioned_seqlock &operator=(versioned_seqlock &&)      = delete;
+
+    /*
+     * only one thread may call store.
+     */
+    void store(const T &value) noexcept
+    {
+        const std::size_t next = version_.load(std::memory_order::relaxed) + 1;
+        slot &s                = slots_[next & mask];
+
+        const std::size_t seq = s.seq_.load(std::memory_order::relaxed);
+        s.seq_.store(seq + 1, std::memory_order::relaxed);
+        std::atomic_thread_fence(std::memory_order::release);
+
+        std::memcpy(&s.value_, &value, sizeof(T));
+
+        s.seq_.store(seq + 2, std::memory_order::release);
+        version_.store(next, std::memory_order::release);
+    }
+
+    bool try_load(T &out) const noexcept
+    {
+        const slot &s = slots_[version_.load(std::memory_order::acquire) & mask];
+
+        const std::size_t before = s.seq_.load(std::memory_order::acquire);
+        if (before & 1)
+        {
+            return false;
+        }
+
+        std::memcpy(&out, &s.value_, sizeof(T));
+        std::atomic_thread_fence(std::memory_order::acquire);
+
+        return before == s.seq_.load(std::memory_order::relaxed);
+    }
+
+    [[nodiscard]] T load() const noexcept
+    {
+        T result;
+        while (!try_load(result))
+        {
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::size_t version() const noexcept
+    {
+        return version_.load(std::memory_order::acquire);
+    }
+};
+
+} // namespace jc::lockfree
+
+#endif
@@ -1,136 +1,562 @@
 #ifndef JC_SPSC_H
 #define JC_SPSC_H
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <bit>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <new>
 #include <optional>
+#include <span>
+#include <thread>
 #include <type_traits>
 
+#include <jc_collections/collections/conditional.hpp>
+#include <jc_collections/memory/stream_copy.hpp>
+#include <jc_collections/util.h>
+
 namespace jc::lockfree
 {
 
 template <std::size_t sz>
 concept is_power_of_two = std::has_single_bit(sz);
 
+namespace spsc_policy
+{
 /*
- * This class is provided with the expectation that memory is managed externally. It is intended to be used
- * in a low latency environment with arena allocation or some other form of allocation. As a consequence,
- * items are copied to the internal buffer, and cannot be complex types with pointers to external data.
+ * index caching: whether each side keeps a private copy of the other side's index and only reloads the shared atomic
+ * when the copy says the ring is full/empty, or reads the other side's cache line on every call. The atomic is a
+ * parameter so the tests can run the real queue on an instrumented one.
  */
-template <typename T, std::size_t sz = 512>
-    requires is_power_of_two<sz> && std::is_move_constructible_v<T> && std::is_move_assignable_v<T> &&
-             std::is_trivially_destructible_v<T>
-class simple_spsc
+template <template <typename> typename Atomic = std::atomic>
+struct basic_shared_indexes
 {
-private:
-    static constexpr std::size_t alignment_size  = std::max(sizeof(T), std::hardware_destructive_interference_size);
-    alignas(64) std::atomic<std::size_t> writer_ = 0;
-    alignas(64) std::atomic<std::size_t> reader_ = 0;
-    alignas(alignment_size) std::array<T, sz> items_;
+    struct side
+    {
+        Atomic<std::size_t> idx_ = 0;
+    };
 
-public:
-    simple_spsc() = default;
+    template <std::size_t sz>
+    static bool full(side &, const std::size_t idx, const side &other) noexcept
+    {
+        return idx - other.idx_.load(std::memory_order::acquire) == sz;
+    }
+
+    static bool empty(side &, const std::size_t idx, const side &other) noexcept
+    {
+        return idx == other.idx_.load(std::memory_order::acquire);
+    }
 
-    simple_spsc(const simple_spsc &)            = delete;
-    simple_spsc &operator=(const simple_spsc &) = delete;
-    simple_spsc(simple_spsc &&)                 = delete;
-    simple_spsc &operator=(simple_spsc &&)      = delete;
+    template <std::size_t sz>
+    static std::size_t room(side &, const std::size_t idx, const side &other, std::size_t) noexcept
+    {
+        return sz - (idx - other.idx_.load(std::memory_order::acquire));
+    }
+};
 
-    ~simple_spsc() = default;
+template <template <typename> typename Atomic = std::atomic>
+struct basic_cached_indexes
+{
+    struct side
+    {
+        Atomic<std::size_t> idx_ = 0;
+        std::size_t cached_idx_  = 0;
+    };
 
-    bool try_put(T &&element)
+    template <std::size_t sz>
+    static bool full(side &self, const std::size_t idx, const side &other) noexcept
     {
-        std::size_t idx = writer_.load(std::memory_order::relaxed);
-        if (idx - reader_.load(std::memory_order::acquire) == sz)
+        if (idx - self.cached_idx_ == sz)
         {
-            return false;
+            self.cached_idx_ = other.idx_.load(std::memory_order::acquire);
         }
-        items_[idx & (sz - 1)] = std::move(element);
-        writer_.store(idx + 1, std::memory_order::release);
-        return true;
+        return idx - self.cached_idx_ == sz;
     }
 
-    void put(T &&element)
+    static bool empty(side &self, const std::size_t idx, const side &other) noexcept
     {
-        std::size_t idx = writer_.load(std::memory_order::relaxed);
-        while (idx - reader_.load(std::memory_order::acquire) == sz)
+        if (idx == self.cached_idx_)
         {
+            self.cached_idx_ = other.idx_.load(std::memory_order::acquire);
         }
-        items_[idx & (sz - 1)] = std::move(element);
-        writer_.store(idx + 1, std::memory_order::release);
+        return idx == self.cached_idx_;
     }
 
-    std::optional<T> try_read()
+    template <std::size_t sz>
+    static std::size_t room(side &self, const std::size_t idx, const side &other, const std::size_t wanted) noexcept
     {
-        std::size_t idx = reader_.load(std::memory_order::relaxed);
-        if (idx == writer_.load(std::memory_order::acquire))
+        if (sz - (idx - self.cached_idx_) < wanted)
         {
-            return {};
+            self.cached_idx_ = other.idx_.load(std::memory_order::acquire);
         }
-        T element = std::move(items_[idx & (sz - 1)]);
-        reader_.store(idx + 1, std::memory_order::release);
-        return element;
+        return sz - (idx - self.cached_idx_);
+    }
+};
+
+using shared_indexes = basic_shared_indexes<>;
+using cached_indexes = basic_cached_indexes<>;
+
+/*
+ * padding: how far apart the writer index, the reader index and the slots are kept. double_line also keeps the
+ * adjacent line prefetcher from pulling the other side's line in.
+ */
+enum class padding : u8
+{
+    none,
+    cache_line,
+    double_line,
+};
+
+/*
+ * wait strategy for the blocking put/emplace/read.
+ */
+struct spin_wait
+{
+    static void wait() noexcept
+    {
+    }
+};
+
+struct pause_wait
+{
+    static void wait() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+};
+
+struct yield_wait
+{
+    static void wait() noexcept
+    {
+        std::this_thread::yield();
     }
+};
 
-    T read()
+/*
+ * element transfer: how a value gets into and out of its slot. memcpy_transfer needs a trivially copyable T,
+ * emplace_transfer builds the element in the slot instead of assigning over the old one.
+ */
+struct move_transfer
+{
+    template <typename T, typename... Args>
+    static void store(T &slot, Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args &&...>)
     {
-        std::size_t idx = reader_.load(std::memory_order::relaxed);
-        while (idx == writer_.load(std::memory_order::acquire))
+        if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, T> && ...))
         {
+            slot = (std::forward<Args>(args), ...);
+        }
+        else
+        {
+            slot = T(std::forward<Args>(args)...);
+        }
+    }
+
+    template <typename T>
+    static T load(T &slot) noexcept
+    {
+        return std::move(slot);
+    }
+};
+
+struct memcpy_transfer
+{
+    template <typename T, typename... Args>
+    static void store(T &slot, Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args &&...>)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "memcpy_transfer needs a trivially copyable element");
+        if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, T> && ...))
+        {
+            std::memcpy(&slot, &args..., sizeof(T));
+        }
+        else
+        {
+            const T element(std::forward<Args>(args)...);
+            std::memcpy(&slot, &element, sizeof(T));
+        }
+    }
+
+    template <typename T>
+    static T load(T &slot) noexcept
+    {
+        T result;
+        std::memcpy(&result, &slot, sizeof(T));
+        return result;
+    }
+};
+
+struct emplace_transfer
+{
+    template <typename T, typename... Args>
+    static void store(T &slot, Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args &&...>)
+    {
+        // elements are trivially destructible, so the old one doesn't need destroying first
+        new (&slot) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static T load(T &slot) noexcept
+    {
+        return std::move(slot);
+    }
+};
+
+/*
+ * streaming_transfer: elements of at least `threshold` bytes are copied into their slot with non-temporal stores
+ * (AVX-512, AVX2 or SSE2, picked at runtime), so a producer pushing large payloads to e.g. a journaling thread doesn't
+ * evict its own working set with lines only the consumer will read. The stores are fenced once before the index is
+ * published. Smaller or non trivially copyable elements are moved like move_transfer, decided at compile time.
+ */
+template <std::size_t threshold = 1024>
+struct streaming_transfer
+{
+    template <typename T>
+    static constexpr bool streams = sizeof(T) >= threshold && std::is_trivially_copyable_v<T>;
+
+    template <typename T, typename... Args>
+    static void store(T &slot, Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args &&...>)
+    {
+        if constexpr (!streams<T>)
+        {
+            move_transfer::store(slot, std::forward<Args>(args)...);
+        }
+        else if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, T> && ...))
+        {
+            jc::memory::stream_copy(&slot, &args..., sizeof(T));
+        }
+        else
+        {
+            const T element(std::forward<Args>(args)...);
+            jc::memory::stream_copy(&slot, &element, sizeof(T));
+        }
+    }
+
+    template <typename T>
+    static T load(T &slot) noexcept
+    {
+        return std::move(slot);
+    }
+
+    template <typename T>
+    static void publish() noexcept
+    {
+        if constexpr (streams<T>)
+        {
+            jc::memory::stream_fence();
+        }
+    }
+};
+
+/*
+ * bounds behaviour: bounded checks for room before every put. unchecked leaves that to the caller, e.g. a producer
+ * that holds credits handed back by the consumer and can never have more than sz elements in flight, and skips the
+ * consumer's cache line entirely on the put side.
+ */
+struct bounded
+{
+    static constexpr bool checked = true;
+};
+
+struct unchecked
+{
+    static constexpr bool checked = false;
+};
+
+/*
+ * prefetching: prefetch_ahead touches the slot `lines` cache lines past the current one, with write intent on the
+ * producer side and for reading on the consumer side, so neither side takes the miss on a cold slot. Only slots that
+ * start a new line issue a prefetch, small elements don't pay for one per call.
+ */
+struct no_prefetch
+{
+    static constexpr std::size_t lines = 0;
+
+    template <typename T>
+    static void producer(const T *) noexcept
+    {
+    }
+
+    template <typename T>
+    static void consumer(const T *) noexcept
+    {
+    }
+};
+
+template <std::size_t ahead, bool on_producer = true, bool on_consumer = true>
+    requires(ahead > 0)
+struct prefetch_ahead
+{
+    static constexpr std::size_t lines = ahead;
+
+    template <int write, typename T>
+    static void prefetch_slot(const T *slot) noexcept
+    {
+        constexpr std::uintptr_t line = std::hardware_destructive_interference_size;
+        const auto address            = reinterpret_cast<std::uintptr_t>(slot);
+        for (std::uintptr_t at = (address + line - 1) & ~(line - 1); at < address + sizeof(T); at += line)
+        {
+            __builtin_prefetch(reinterpret_cast<const void *>(at), write, 3);
+        }
+    }
+
+    template <typename T>
+    static void producer(const T *slot) noexcept
+    {
+        if constexpr (on_producer)
+        {
+            prefetch_slot<1>(slot);
         }
-        T element = std::move(items_[idx & (sz - 1)]);
-        reader_.store(idx + 1, std::memory_order::release);
-        return element;
     }
+
+    template <typename T>
+    static void consumer(const T *slot) noexcept
+    {
+        if constexpr (on_consumer)
+        {
+            prefetch_slot<0>(slot);
+        }
+    }
+};
+
+/*
+ * index batching, after FastForward/MCRingBuffer: how many elements a side handles before it publishes its index.
+ * Publishing every element moves that side's line to the other core once per element, a batch of n moves it once
+ * per n at the cost of the other side seeing the elements (or the free slots) up to n - 1 late.
+ *
+ * release_* is the consumer's read index, publish_* the producer's write index. release_per_line batches a cache
+ * line's worth of slots. A side always publishes whatever it has pending before it waits or reports full/empty, and
+ * flush_reads()/flush_writes() publish on demand, so batching never leaves both sides waiting on each other.
+ */
+struct release_each
+{
+    template <typename T>
+    static constexpr std::size_t batch = 1;
+};
+
+template <std::size_t n>
+    requires(n > 0)
+struct release_every
+{
+    template <typename T>
+    static constexpr std::size_t batch = n;
+};
+
+struct release_per_line
+{
+    template <typename T>
+    static constexpr std::size_t batch =
+        std::bit_floor(std::max<std::size_t>(1, std::hardware_destructive_interference_size / sizeof(T)));
 };
 
+struct publish_each
+{
+    template <typename T>
+    static constexpr std::size_t batch = 1;
+};
+
+template <std::size_t n>
+    requires(n > 0)
+struct publish_every
+{
+    template <typename T>
+    static constexpr std::size_t batch = n;
+};
+} // namespace spsc_policy
+
 /*
  * This class is provided with the expectation that memory is managed externally. It is intended to be used
  * in a low latency environment with arena allocation or some other form of allocation. As a consequence,
  * items are copied to the internal buffer, and cannot be complex types with pointers to external data.
+ *
+ * Every behaviour that used to tell the queues apart is a policy resolved at compile time, see spsc_policy. The
+ * blocking calls spin on the wait policy; put/emplace/try_put go through the transfer policy, emplace always builds
+ * the element in place.
  */
-template <typename T, std::size_t sz = 512>
+template <typename T, std::size_t sz = 512, typename indexing = spsc_policy::cached_indexes,
+          spsc_policy::padding pad = spsc_policy::padding::cache_line, typename waiting = spsc_policy::spin_wait,
+          typename transfer = spsc_policy::move_transfer, typename bounds = spsc_policy::bounded,
+          typename prefetch = spsc_policy::no_prefetch, typename release = spsc_policy::release_each,
+          typename publishing = spsc_policy::publish_each>
     requires is_power_of_two<sz> && std::is_move_constructible_v<T> && std::is_move_assignable_v<T> &&
              std::is_trivially_destructible_v<T>
-class cached_spsc
+class basic_spsc
 {
 private:
     static constexpr std::size_t mask = sz - 1;
-    struct aligned_indexes
+    using side                        = typename indexing::side;
+
+    static constexpr std::size_t alignment =
+        cond<static_cast<TempOption>(pad), std::integral_constant<std::size_t, alignof(side)>,
+             std::integral_constant<std::size_t, std::hardware_destructive_interference_size>,
+             std::integral_constant<std::size_t, 2 * std::hardware_destructive_interference_size>>::type::value;
+
+    static constexpr std::size_t release_batch = std::min(sz, release::template batch<T>);
+    static constexpr std::size_t publish_batch = std::min(sz, publishing::template batch<T>);
+    static constexpr std::size_t prefetch_slots =
+        prefetch::lines == 0 ? 0
+                             : std::max<std::size_t>(
+                                   1, prefetch::lines * std::hardware_destructive_interference_size / sizeof(T));
+    static_assert(prefetch_slots < sz, "prefetching a whole ring ahead lands on the slot being used");
+
+    template <std::size_t batch>
+    struct unused
     {
-        std::atomic<std::size_t> idx_ = 0;
-        std::size_t cached_idx_       = 0;
     };
+    /* each side's own position when its published index lags behind, kept on that side's line */
+    using write_position = std::conditional_t<(publish_batch > 1), std::size_t, unused<0>>;
+    using read_position  = std::conditional_t<(release_batch > 1), std::size_t, unused<1>>;
 
-    static constexpr std::size_t padding_size = std::hardware_destructive_interference_size - sizeof(aligned_indexes);
+    alignas(alignment) side writer_;
+    [[no_unique_address]] write_position write_pos_{};
+    alignas(alignment) side reader_;
+    [[no_unique_address]] read_position read_pos_{};
+    alignas(std::max(alignment, alignof(T))) std::array<T, sz> items_;
 
-    alignas(std::hardware_destructive_interference_size) aligned_indexes writer_;
-    alignas(std::hardware_destructive_interference_size) aligned_indexes reader_;
-    uint8_t padding[padding_size]{};
-    std::array<T, sz> items_;
+    void prefetch_for_write(const std::size_t idx) noexcept
+    {
+        if constexpr (prefetch_slots > 0)
+        {
+            prefetch::producer(&items_[(idx + prefetch_slots) & mask]);
+        }
+    }
 
-public:
-    cached_spsc() = default;
-    bool try_put(T &&element)
+    std::size_t write_idx() const noexcept
+    {
+        if constexpr (publish_batch > 1)
+        {
+            return write_pos_;
+        }
+        else
+        {
+            return writer_.idx_.load(std::memory_order::relaxed);
+        }
+    }
+
+    /* makes elements up to `idx` visible, after whatever fence the transfer's stores need */
+    void publish_now(const std::size_t idx) noexcept
+    {
+        if constexpr (publish_batch > 1)
+        {
+            write_pos_ = idx;
+        }
+        if constexpr (requires { transfer::template publish<T>(); })
+        {
+            transfer::template publish<T>();
+        }
+        writer_.idx_.store(idx, std::memory_order::release);
+    }
+
+    void publish(const std::size_t idx) noexcept
+    {
+        if constexpr (publish_batch > 1)
+        {
+            write_pos_ = idx;
+            if (idx - writer_.idx_.load(std::memory_order::relaxed) < publish_batch)
+            {
+                return;
+            }
+        }
+        publish_now(idx);
+    }
+
+    template <typename... Args>
+    void store(const std::size_t idx, Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args &&...>)
+    {
+        prefetch_for_write(idx);
+        transfer::store(items_[idx & mask], std::forward<Args>(args)...);
+        publish(idx + 1);
+    }
+
+    std::size_t read_idx() const noexcept
+    {
+        if constexpr (release_batch > 1)
+        {
+            return read_pos_;
+        }
+        else
+        {
+            return reader_.idx_.load(std::memory_order::relaxed);
+        }
+    }
+
+    T load(const std::size_t idx) noexcept
+    {
+        if constexpr (prefetch_slots > 0)
+        {
+            prefetch::consumer(&items_[(idx + prefetch_slots) & mask]);
+        }
+        T element = transfer::load(items_[idx & mask]);
+        if constexpr (release_batch > 1)
+        {
+            read_pos_ = idx + 1;
+            if (idx + 1 - reader_.idx_.load(std::memory_order::relaxed) < release_batch)
+            {
+                return element;
+            }
+        }
+        reader_.idx_.store(idx + 1, std::memory_order::release);
+        return element;
+    }
+
+    bool full(const std::size_t idx) noexcept
     {
-        std::size_t idx = writer_.idx_.load(std::memory_order::relaxed);
-        if (idx - writer_.cached_idx_ == sz)
+        if (!indexing::template full<sz>(writer_, idx, reader_))
         {
-            writer_.cached_idx_ = reader_.idx_.load(std::memory_order_acquire);
+            return false;
         }
+        flush_writes();
+        return true;
+    }
 
-        if (idx - writer_.cached_idx_ == sz)
+    bool empty(const std::size_t idx) noexcept
+    {
+        if (!indexing::empty(reader_, idx, writer_))
         {
             return false;
         }
+        flush_reads();
+        return true;
+    }
+
+    std::size_t wait_for_room() noexcept
+    {
+        const std::size_t idx = write_idx();
+        if constexpr (bounds::checked)
+        {
+            while (full(idx))
+            {
+                waiting::wait();
+            }
+        }
+        return idx;
+    }
+
+public:
+    basic_spsc() = default;
+
+    basic_spsc(const basic_spsc &)            = delete;
+    basic_spsc &operator=(const basic_spsc &) = delete;
+    basic_spsc(basic_spsc &&)                 = delete;
+    basic_spsc &operator=(basic_spsc &&)      = delete;
 
-        items_[idx & mask] = std::move(element);
-        writer_.idx_.store(idx + 1, std::memory_order::release);
+    ~basic_spsc() = default;
 
+    bool try_put(T &&element) noexcept
+    {
+        const std::size_t idx = write_idx();
+        if constexpr (bounds::checked)
+        {
+            if (full(idx))
+            {
+                return false;
+            }
+        }
+        store(idx, std::move(element));
         return true;
     }
 
@@ -142,15 +568,10 @@ public:
     template <typename... Args>
     void emplace(Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args &&...>)
     {
-        auto const idx = writer_.idx_.load(std::memory_order::relaxed);
-
-        while (idx - writer_.cached_idx_ == sz)
-        {
-            writer_.cached_idx_ = reader_.idx_.load(std::memory_order_acquire);
-        }
-
+        const std::size_t idx = wait_for_room();
+        prefetch_for_write(idx);
         new (&items_[idx & mask]) T(std::forward<Args>(args)...);
-        writer_.idx_.store(idx + 1, std::memory_order::release);
+        publish(idx + 1);
     }
 
     /*
@@ -160,38 +581,66 @@ public:
      */
     void put(T &&element) noexcept
     {
-        emplace(std::move(element));
+        store(wait_for_room(), std::move(element));
     }
 
     void put(T &element) noexcept
     {
-        std::size_t idx = writer_.idx_.load(std::memory_order::relaxed);
-        while (idx - writer_.cached_idx_ == sz)
+        store(wait_for_room(), element);
+    }
+
+    /*
+     * copies as many of `elements` as there is room for and publishes them together, returns how many went in.
+     */
+    std::size_t try_put_bulk(std::span<const T> elements) noexcept
+    {
+        const std::size_t idx = write_idx();
+        std::size_t count     = elements.size();
+        if constexpr (bounds::checked)
         {
-            writer_.cached_idx_ = reader_.idx_.load(std::memory_order_acquire);
+            count = std::min(count, indexing::template room<sz>(writer_, idx, reader_, count));
         }
-
-        std::memcpy(&items_[idx & mask], &element, sizeof(T));
-        writer_.idx_.store(idx + 1, std::memory_order::release);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            prefetch_for_write(idx + i);
+            transfer::store(items_[(idx + i) & mask], elements[i]);
+        }
+        if (count < elements.size())
+        {
+            // out of room, the consumer needs to see everything to make any
+            publish_now(idx + count);
+        }
+        else
+        {
+            publish(idx + count);
+        }
+        return count;
     }
 
-    std::optional<T> try_read()
+    /*
+     * spin here until every element is in, publishing whatever fits each time round.
+     */
+    void put_bulk(std::span<const T> elements) noexcept
     {
-        std::size_t idx = reader_.idx_.load(std::memory_order::relaxed);
-        if (idx == reader_.cached_idx_)
+        while (true)
         {
-            reader_.cached_idx_ = writer_.idx_.load(std::memory_order_acquire);
+            elements = elements.subspan(try_put_bulk(elements));
+            if (elements.empty())
+            {
+                return;
+            }
+            waiting::wait();
         }
+    }
 
-        if (idx == reader_.cached_idx_)
+    std::optional<T> try_read() noexcept
+    {
+        const std::size_t idx = read_idx();
+        if (empty(idx))
         {
             return {};
         }
-
-        T element = std::move(items_[idx & mask]);
-
-        reader_.idx_.store(idx + 1, std::memory_order::release);
-        return element;
+        return load(idx);
     }
 
     /*
@@ -200,17 +649,53 @@ public:
      */
     [[nodiscard]] T read() noexcept
     {
-        std::size_t idx = reader_.idx_.load(std::memory_order::relaxed);
-        while (idx == reader_.cached_idx_)
+        const std::size_t idx = read_idx();
+        while (empty(idx))
         {
-            reader_.cached_idx_ = writer_.idx_.load(std::memory_order_acquire);
+            waiting::wait();
         }
+        return load(idx);
+    }
 
-        T result;
-        __builtin_memcpy(&result, &items_[idx & mask], sizeof(T));
-        reader_.idx_.store(idx + 1, std::memory_order::release);
-        return result;
+    /*
+     * producer side: publishes writes a publish_every batch is still holding back, e.g. at the end of a burst.
+     */
+    void flush_writes() noexcept
+    {
+        if constexpr (publish_batch > 1)
+        {
+            if (write_pos_ != writer_.idx_.load(std::memory_order::relaxed))
+            {
+                publish_now(write_pos_);
+            }
+        }
+    }
+
+    /*
+     * consumer side: hands slots a release batch is still holding back to the producer.
+     */
+    void flush_reads() noexcept
+    {
+        if constexpr (release_batch > 1)
+        {
+            if (read_pos_ != reader_.idx_.load(std::memory_order::relaxed))
+            {
+                reader_.idx_.store(read_pos_, std::memory_order::release);
+            }
+        }
     }
 };
+
+/*
+ * loads the other side's index on every call.
+ */
+template <typename T, std::size_t sz = 512>
+using simple_spsc = basic_spsc<T, sz, spsc_policy::shared_indexes>;
+
+/*
+ * only reloads the other side's index when its cached copy says the ring is full or empty.
+ */
+template <typename T, std::size_t sz = 512>
+using cached_spsc = basic_spsc<T, sz, spsc_policy::cached_indexes>;
 } // namespace jc::lockfree
 #endif
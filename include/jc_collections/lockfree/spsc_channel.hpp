@@ -0,0 +1,223 @@
+#ifndef JC_SPSC_CHANNEL_H
+#define JC_SPSC_CHANNEL_H
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <jc_collections/lockfree/coroutine_scheduler.hpp>
+#include <jc_collections/lockfree/spsc.hpp>
+
+namespace jc::lockfree
+{
+
+/*
+ * cached_spsc with awaitable ends for co_tasks. co_put suspends the producer while the ring is full and co_read
+ * suspends the consumer while it is empty; the other side wakes them through their scheduler after it makes progress.
+ * Before suspending both sides busy-poll for `spin_count` attempts, which is usually enough for a cross thread peer to
+ * catch up and keeps the common path free of scheduler round trips.
+ *
+ * Each side registers itself as the waiter and then re-checks the ring, while the peer publishes its progress and then
+ * checks for a waiter. A full fence on both sides guarantees at least one of them sees the other, so a wakeup is never
+ * lost.
+ */
+template <typename T, std::size_t sz = 512, std::size_t spin_count = 64>
+    requires is_power_of_two<sz> && std::is_move_constructible_v<T> && std::is_move_assignable_v<T> &&
+             std::is_trivially_destructible_v<T>
+class spsc_channel
+{
+private:
+    using promise_type = co_task::promise_type;
+
+    cached_spsc<T, sz> queue_;
+    alignas(std::hardware_destructive_interference_size) std::atomic<promise_type *> waiting_reader_ = nullptr;
+    alignas(std::hardware_destructive_interference_size) std::atomic<promise_type *> waiting_writer_ = nullptr;
+
+    static void wake(std::atomic<promise_type *> &waiter) noexcept
+    {
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (waiter.load(std::memory_order::relaxed) == nullptr)
+        {
+            return;
+        }
+        if (promise_type *promise = waiter.exchange(nullptr, std::memory_order::acq_rel))
+        {
+            promise->wake();
+        }
+    }
+
+    /*
+     * register as the waiter and give `attempt` one more go. Returns true if the coroutine should stay suspended.
+     */
+    template <typename Attempt>
+    static bool park(std::atomic<promise_type *> &waiter, promise_type &promise, Attempt &&attempt) noexcept
+    {
+        waiter.store(&promise, std::memory_order::release);
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (!attempt())
+        {
+            return true;
+        }
+        // made progress after all, if the peer already claimed us a wakeup is on its way and we must wait for it
+        return waiter.exchange(nullptr, std::memory_order::acq_rel) == nullptr;
+    }
+
+public:
+    spsc_channel() = default;
+
+    spsc_channel(const spsc_channel &)            = delete;
+    spsc_channel &operator=(const spsc_channel &) = delete;
+    spsc_channel(spsc_channel &&)                 = delete;
+    spsc_channel &operator=(spsc_channel &&)      = delete;
+
+    class put_awaiter
+    {
+    public:
+        put_awaiter(spsc_channel &channel, T &&value) noexcept : channel_(channel), value_(std::move(value))
+        {
+        }
+
+        bool await_ready() noexcept
+        {
+            for (std::size_t i = 0; i < spin_count; i++)
+            {
+                if (try_put())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+        {
+            return park(channel_.waiting_writer_, handle.promise(), [this] { return try_put(); });
+        }
+
+        void await_resume() noexcept
+        {
+            // woken by the reader, so there is room now and only this producer can fill it
+            if (!done_)
+            {
+                channel_.queue_.put(std::move(value_));
+                wake(channel_.waiting_reader_);
+            }
+        }
+
+    private:
+        bool try_put() noexcept
+        {
+            if (!channel_.queue_.try_put(std::move(value_)))
+            {
+                return false;
+            }
+            done_ = true;
+            wake(channel_.waiting_reader_);
+            return true;
+        }
+
+        spsc_channel &channel_;
+        T value_;
+        bool done_ = false;
+    };
+
+    class read_awaiter
+    {
+    public:
+        explicit read_awaiter(spsc_channel &channel) noexcept : channel_(channel)
+        {
+        }
+
+        bool await_ready() noexcept
+        {
+            for (std::size_t i = 0; i < spin_count; i++)
+            {
+                if (try_read())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+        {
+            return park(channel_.waiting_reader_, handle.promise(), [this] { return try_read(); });
+        }
+
+        T await_resume() noexcept
+        {
+            // woken by the writer, so an element is there and only this consumer can take it
+            if (!value_)
+            {
+                while (!(value_ = channel_.queue_.try_read()))
+                {
+                }
+                wake(channel_.waiting_writer_);
+            }
+            return std::move(*value_);
+        }
+
+    private:
+        bool try_read() noexcept
+        {
+            value_ = channel_.queue_.try_read();
+            if (!value_)
+            {
+                return false;
+            }
+            wake(channel_.waiting_writer_);
+            return true;
+        }
+
+        spsc_channel &channel_;
+        std::optional<T> value_;
+    };
+
+    /*
+     * only one coroutine may put at a time.
+     */
+    [[nodiscard]] put_awaiter co_put(T value) noexcept
+    {
+        return put_awaiter(*this, std::move(value));
+    }
+
+    /*
+     * only one coroutine may read at a time.
+     */
+    [[nodiscard]] read_awaiter co_read() noexcept
+    {
+        return read_awaiter(*this);
+    }
+
+    /*
+     * plain non blocking access for producers or consumers that are not coroutines.
+     */
+    bool try_put(T &&element) noexcept
+    {
+        if (!queue_.try_put(std::move(element)))
+        {
+            return false;
+        }
+        wake(waiting_reader_);
+        return true;
+    }
+
+    std::optional<T> try_read() noexcept
+    {
+        std::optional<T> element = queue_.try_read();
+        if (element)
+        {
+            wake(waiting_writer_);
+        }
+        return element;
+    }
+};
+
+} // namespace jc::lockfree
+
+#endif
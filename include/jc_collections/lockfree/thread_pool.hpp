@@ -0,0 +1,393 @@
+#ifndef JC_THREAD_POOL_H
+#define JC_THREAD_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <jc_collections/lockfree/work_stealing_deque.hpp>
+#include <jc_collections/memory/base_allocator.hpp>
+
+namespace jc::lockfree
+{
+
+/*
+ * pins the calling thread to a single core, returns false if the platform doesn't support it or the call failed.
+ */
+inline bool pin_current_thread(const int core_id) noexcept
+{
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(core_id, &cpu_set);
+
+    pthread_t current_thread = pthread_self();
+    return pthread_setaffinity_np(current_thread, sizeof(cpu_set_t), &cpu_set) == 0;
+#else
+    (void)core_id;
+    return false;
+#endif
+}
+
+/*
+ * A unit of work handed between workers. Tasks are owned by the frame that forks them, which always waits for them
+ * to finish, so they can live on the stack and the pool never allocates per task.
+ */
+struct task
+{
+    void (*run_)(task *)    = nullptr;
+    std::atomic<bool> done_ = false;
+};
+
+template <typename F>
+class closure_task final : public task
+{
+public:
+    explicit closure_task(F &fn) noexcept : fn_(fn)
+    {
+        run_ = &invoke;
+    }
+
+private:
+    static void invoke(task *self)
+    {
+        static_cast<closure_task *>(self)->fn_();
+    }
+
+    F &fn_;
+};
+
+/*
+ * Fork/join thread pool built on work_stealing_deque. Every worker owns a deque and pushes the work it forks onto it;
+ * idle workers steal the oldest work from a random victim. A thread waiting on a join keeps running tasks rather
+ * than blocking, so nested parallelism never deadlocks and never parks a core.
+ *
+ * Each worker can be pinned to a core (same approach as the benchmarks' set_thread_affinity) and owns a
+ * base_allocator arena. The worker's deque is placed in its arena from the worker thread itself so the pages are
+ * first touched on the core that uses them, the rest of the arena is available to tasks through worker_arena().
+ *
+ * A single external thread drives the pool through run(), it gets a deque of its own and helps out while it waits.
+ * Tasks must not throw.
+ */
+template <std::size_t deque_size = 1024>
+class thread_pool
+{
+private:
+    using deque_type = work_stealing_deque<task *, deque_size>;
+
+    struct worker
+    {
+        explicit worker(thread_pool &pool, const std::size_t arena_bytes, const std::uint64_t seed) noexcept
+            : pool_(&pool), arena_(arena_bytes), rng_state_(seed)
+        {
+        }
+
+        bool init() noexcept
+        {
+            void *storage = arena_.allocate(sizeof(deque_type), alignof(deque_type));
+            if (storage == nullptr)
+            {
+                return false;
+            }
+            deque_ = new (storage) deque_type();
+            return true;
+        }
+
+        // the thread local current_ is shared by every pool of this type, so each worker records which pool it is in
+        thread_pool *pool_;
+        memory::base_allocator arena_;
+        deque_type *deque_ = nullptr;
+        std::uint64_t rng_state_;
+    };
+
+public:
+    static constexpr std::size_t default_arena_bytes = std::size_t{1} << 20;
+    // failed steal attempts before an idle worker starts yielding its core
+    static constexpr std::size_t spin_limit = 1024;
+
+    /**
+     * @param worker_count number of worker threads, the driving thread is not counted
+     * @param cores worker i is pinned to cores[i], workers past the end of the span are not pinned
+     * @param arena_bytes size of each worker's arena
+     */
+    explicit thread_pool(const std::size_t worker_count, std::span<const int> cores = {},
+                         const std::size_t arena_bytes = default_arena_bytes)
+        : driver_(*this, arena_bytes, worker_count + 1), ready_(static_cast<std::ptrdiff_t>(worker_count + 1))
+    {
+        initialised_ = driver_.init();
+
+        workers_.reserve(worker_count);
+        for (std::size_t i = 0; i < worker_count; i++)
+        {
+            workers_.push_back(std::make_unique<worker>(*this, arena_bytes, i + 1));
+        }
+
+        std::atomic<bool> workers_ok = true;
+        threads_.reserve(worker_count);
+        for (std::size_t i = 0; i < worker_count; i++)
+        {
+            const int core = i < cores.size() ? cores[i] : -1;
+            threads_.emplace_back([this, i, core, &workers_ok] {
+                if (core >= 0)
+                {
+                    pin_current_thread(core);
+                }
+                if (!workers_[i]->init())
+                {
+                    workers_ok.store(false, std::memory_order::relaxed);
+                }
+                ready_.arrive_and_wait();
+                worker_loop(*workers_[i]);
+            });
+        }
+        // every deque is published before anyone can steal from it
+        ready_.arrive_and_wait();
+        initialised_ = initialised_ && workers_ok.load(std::memory_order::relaxed);
+    }
+
+    ~thread_pool()
+    {
+        stop_.store(true, std::memory_order::relaxed);
+        for (std::thread &thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    thread_pool(const thread_pool &)            = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+    thread_pool(thread_pool &&)                 = delete;
+    thread_pool &operator=(thread_pool &&)      = delete;
+
+    /**
+     * @brief Checks that every worker arena and deque was set up. Workers that failed never take work, so the pool
+     * still completes everything, just with less parallelism.
+     */
+    [[nodiscard]] bool successful_init() const noexcept
+    {
+        return initialised_;
+    }
+
+    [[nodiscard]] std::size_t worker_count() const noexcept
+    {
+        return workers_.size();
+    }
+
+    /**
+     * @brief The arena of the worker running the calling task, nullptr outside of the pool.
+     */
+    [[nodiscard]] static memory::base_allocator *worker_arena() noexcept
+    {
+        return current_ != nullptr ? &current_->arena_ : nullptr;
+    }
+
+    /**
+     * @brief Runs `fn` on the pool and waits for it and everything it forks. Only one thread may drive the pool.
+     */
+    template <typename F>
+    void run(F &&fn)
+    {
+        if (driver_.deque_ == nullptr) [[unlikely]]
+        {
+            fn();
+            return;
+        }
+
+        worker *previous = std::exchange(current_, &driver_);
+        closure_task<std::remove_reference_t<F>> root(fn);
+        push_or_run(driver_, root);
+        wait_for(driver_, root);
+        current_ = previous;
+    }
+
+    /**
+     * @brief Runs `a` and `b` potentially in parallel, `b` is made available to thieves while this thread runs `a`.
+     * Called outside of this pool's run(), including from a task of another pool, the two simply run in order.
+     */
+    template <typename A, typename B>
+    void join(A &&a, B &&b)
+    {
+        worker *self = current_ != nullptr && current_->pool_ == this ? current_ : nullptr;
+        if (self == nullptr || self->deque_ == nullptr) [[unlikely]]
+        {
+            a();
+            b();
+            return;
+        }
+
+        closure_task<std::remove_reference_t<B>> right(b);
+        push_or_run(*self, right);
+        a();
+        wait_for(*self, right);
+    }
+
+    /**
+     * @brief Calls `fn(i)` for every i in [begin, end), splitting the range in halves down to `grain` iterations.
+     */
+    template <typename F>
+    void parallel_for(const std::size_t begin, const std::size_t end, const std::size_t grain, F &&fn)
+    {
+        if (end - begin <= grain)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                fn(i);
+            }
+            return;
+        }
+
+        const std::size_t mid = begin + ((end - begin) / 2);
+        join([&] { parallel_for(begin, mid, grain, fn); }, [&] { parallel_for(mid, end, grain, fn); });
+    }
+
+    /**
+     * @brief Folds `map(i)` over [begin, end) with `reduce`, `identity` must be the identity of `reduce`.
+     */
+    template <typename T, typename Map, typename Reduce>
+    T parallel_reduce(const std::size_t begin, const std::size_t end, const std::size_t grain, const T &identity,
+                      Map &&map, Reduce &&reduce)
+    {
+        if (end - begin <= grain)
+        {
+            T result = identity;
+            for (std::size_t i = begin; i < end; i++)
+            {
+                result = reduce(result, map(i));
+            }
+            return result;
+        }
+
+        const std::size_t mid = begin + ((end - begin) / 2);
+        T left                = identity;
+        T right               = identity;
+        join([&] { left = parallel_reduce(begin, mid, grain, identity, map, reduce); },
+             [&] { right = parallel_reduce(mid, end, grain, identity, map, reduce); });
+        return reduce(left, right);
+    }
+
+private:
+    static void execute(task *t)
+    {
+        t->run_(t);
+        t->done_.store(true, std::memory_order::release);
+    }
+
+    static void push_or_run(worker &self, task &t)
+    {
+        // a full deque means there is already plenty to steal, so just do the work here
+        if (!self.deque_->push(&t))
+        {
+            execute(&t);
+        }
+    }
+
+    /*
+     * xorshift64, only used to spread thieves over victims.
+     */
+    static std::uint64_t next_random(worker &self) noexcept
+    {
+        std::uint64_t x = self.rng_state_;
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        self.rng_state_ = x;
+        return x;
+    }
+
+    worker &victim(const std::size_t idx) noexcept
+    {
+        return idx < workers_.size() ? *workers_[idx] : driver_;
+    }
+
+    std::optional<task *> steal_one(worker &self) noexcept
+    {
+        const std::size_t participants = workers_.size() + 1;
+        const std::size_t start        = next_random(self) % participants;
+        for (std::size_t i = 0; i < participants; i++)
+        {
+            worker &other = victim((start + i) % participants);
+            if (&other == &self || other.deque_ == nullptr)
+            {
+                continue;
+            }
+            if (std::optional<task *> stolen = other.deque_->steal())
+            {
+                return stolen;
+            }
+        }
+        return {};
+    }
+
+    bool run_one(worker &self)
+    {
+        std::optional<task *> next = self.deque_->pop();
+        if (!next)
+        {
+            next = steal_one(self);
+        }
+        if (!next)
+        {
+            return false;
+        }
+        execute(*next);
+        return true;
+    }
+
+    void wait_for(worker &self, const task &t)
+    {
+        while (!t.done_.load(std::memory_order::acquire))
+        {
+            run_one(self);
+        }
+    }
+
+    void worker_loop(worker &self)
+    {
+        if (self.deque_ == nullptr)
+        {
+            return;
+        }
+        current_ = &self;
+
+        std::size_t idle = 0;
+        while (!stop_.load(std::memory_order::relaxed))
+        {
+            if (run_one(self))
+            {
+                idle = 0;
+            }
+            else if (++idle > spin_limit)
+            {
+                std::this_thread::yield();
+            }
+        }
+        current_ = nullptr;
+    }
+
+    inline static thread_local worker *current_ = nullptr;
+
+    worker driver_;
+    std::vector<std::unique_ptr<worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::latch ready_;
+    std::atomic<bool> stop_ = false;
+    bool initialised_       = false;
+};
+
+} // namespace jc::lockfree
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef JC_TRIPLE_BUFFER_H
+#define JC_TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+#include <jc_collections/lockfree/seqlock.hpp>
+#include <jc_collections/lockfree/spsc.hpp>
+
+namespace jc::lockfree
+{
+
+/*
+ * Wait-free single producer single consumer latest value mailbox. The producer always owns a back buffer, the
+ * consumer always owns a front buffer and the third buffer sits in the middle. Publishing swaps back and middle,
+ * reading swaps front and middle, so neither side ever waits and the consumer always sees the newest complete value;
+ * anything the consumer did not get to in time is overwritten rather than queued.
+ */
+template <typename T>
+    requires std::is_default_constructible_v<T> && std::is_move_assignable_v<T>
+class triple_buffer
+{
+private:
+    // the middle index lives in the low bits, the dirty bit marks a value the consumer has not picked up yet
+    static constexpr std::uint8_t index_mask = 0b011;
+    static constexpr std::uint8_t dirty_bit  = 0b100;
+
+    struct alignas(std::hardware_destructive_interference_size) buffer
+    {
+        T value_{};
+    };
+
+    std::array<buffer, 3> buffers_;
+    alignas(std::hardware_destructive_interference_size) std::atomic<std::uint8_t> middle_ = 1;
+    alignas(std::hardware_destructive_interference_size) std::uint8_t back_ = 0;
+    alignas(std::hardware_destructive_interference_size) std::uint8_t front_ = 2;
+
+public:
+    triple_buffer() = default;
+
+    triple_buffer(const triple_buffer &)            = delete;
+    triple_buffer &operator=(const triple_buffer &) = delete;
+    triple_buffer(triple_buffer &&)                 = delete;
+    triple_buffer &operator=(triple_buffer &&)      = delete;
+
+    /*
+     * producer side, write the next value in place and then call publish().
+     */
+    [[nodiscard]] T &back() noexcept
+    {
+        return buffers_[back_].value_;
+    }
+
+    void publish() noexcept
+    {
+        const std::uint8_t previous = middle_.exchange(back_ | dirty_bit, std::memory_order::acq_rel);
+        back_                       = previous & index_mask;
+    }
+
+    void put(T &&element) noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+        back() = std::move(element);
+        publish();
+    }
+
+    void put(const T &element) noexcept(std::is_nothrow_copy_assignable_v<T>)
+        requires std::is_copy_assignable_v<T>
+    {
+        back() = element;
+        publish();
+    }
+
+    /*
+     * consumer side, pulls in the newest value if one was published since the last call. Returns true if the front
+     * buffer changed.
+     */
+    bool update() noexcept
+    {
+        if (!(middle_.load(std::memory_order::relaxed) & dirty_bit))
+        {
+            return false;
+        }
+        const std::uint8_t previous = middle_.exchange(front_, std::memory_order::acq_rel);
+        front_                      = previous & index_mask;
+        return true;
+    }
+
+    /*
+     * the value most recently picked up by update(), stays valid until the next update().
+     */
+    [[nodiscard]] const T &front() const noexcept
+    {
+        return buffers_[front_].value_;
+    }
+
+    [[nodiscard]] T &front() noexcept
+    {
+        return buffers_[front_].value_;
+    }
+
+    std::optional<T> try_read()
+    {
+        if (!update())
+        {
+            return {};
+        }
+        return std::move(front());
+    }
+};
+
+/*
+ * Single producer single consumer queue that conflates updates per key. Each key in [0, key_count) owns a seqlock
+ * protected slot; the producer overwrites the slot and only enqueues the key if it is not already pending, so a burst
+ * of updates to one key costs the consumer a single read of the latest value. Every key is queued at most once, so
+ * the key ring can never fill up and the producer never waits.
+ *
+ * A key updated after the consumer picked it up is queued again, meaning the consumer may occasionally see the same
+ * value twice but never misses the latest one.
+ */
+template <typename T, std::size_t key_count>
+    requires is_power_of_two<key_count> && std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+class conflating_queue
+{
+private:
+    struct alignas(std::hardware_destructive_interference_size) slot
+    {
+        seqlock<T> value_;
+        std::atomic<bool> pending_ = false;
+    };
+
+    std::array<slot, key_count> slots_;
+    cached_spsc<std::size_t, key_count> keys_;
+
+public:
+    conflating_queue() = default;
+
+    conflating_queue(const conflating_queue &)            = delete;
+    conflating_queue &operator=(const conflating_queue &) = delete;
+    conflating_queue(conflating_queue &&)                 = delete;
+    conflating_queue &operator=(conflating_queue &&)      = delete;
+
+    /*
+     * keys outside [0, key_count) are rejected.
+     */
+    bool put(const std::size_t key, const T &element) noexcept
+    {
+        if (key >= key_count) [[unlikely]]
+        {
+            return false;
+        }
+
+        slot &s = slots_[key];
+        s.value_.store(element);
+        if (!s.pending_.exchange(true, std::memory_order::acq_rel))
+        {
+            keys_.emplace(key);
+        }
+        return true;
+    }
+
+    /*
+     * fills in the next updated key and its newest value, returns false if nothing changed.
+     */
+    bool try_read(std::size_t &key, T &element) noexcept
+    {
+        const std::optional<std::size_t> next = keys_.try_read();
+        if (!next)
+        {
+            return false;
+        }
+
+        key     = *next;
+        slot &s = slots_[key];
+        // clear before copying so an update racing with the copy re-queues the key instead of being lost
+        s.pending_.exchange(false, std::memory_order::acq_rel);
+        element = s.value_.load();
+        return true;
+    }
+};
+
+} // namespace jc::lockfree
+
+#endif
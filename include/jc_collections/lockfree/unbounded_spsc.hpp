@@ -0,0 +1,299 @@
+#ifndef JC_UNBOUNDED_SPSC_H
+#define JC_UNBOUNDED_SPSC_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <jc_collections/util.h>
+
+namespace jc::lockfree
+{
+
+/*
+ * Single producer single consumer queue that never refuses an element. It is a chain of fixed size segments, each
+ * a plain array with a published write count, so within a segment it behaves like cached_spsc except the producer
+ * never has to look at the consumer: a full segment just means linking another one.
+ *
+ * Drained segments go back to the producer through an intrusive free list (the consumer pushes, the producer takes
+ * the whole list at once, so there is no ABA), which keeps the queue allocation free once it has grown to its
+ * working size. Segments are only returned to the memory resource on destruction, so the queue keeps the high-water
+ * mark of a stall; segments() reports it.
+ */
+template <typename T, std::size_t segment_size = 1024>
+    requires(segment_size > 0) && std::is_move_constructible_v<T>
+class unbounded_spsc
+{
+private:
+    struct segment
+    {
+        alignas(std::hardware_destructive_interference_size) std::atomic<std::size_t> written_ = 0;
+        // the following segment while queued, the next spare one while on a free list
+        std::atomic<segment *> next_ = nullptr;
+        alignas(std::hardware_destructive_interference_size) alignas(T) std::byte items_[sizeof(T) * segment_size];
+
+        T *slot(const std::size_t idx) noexcept
+        {
+            return reinterpret_cast<T *>(items_) + idx;
+        }
+    };
+
+    struct producer_side
+    {
+        segment *tail_   = nullptr;
+        std::size_t idx_ = 0;
+        // spare segments already taken off the shared free list, only the producer touches this chain
+        segment *spare_ = nullptr;
+    };
+
+    struct consumer_side
+    {
+        segment *head_              = nullptr;
+        std::size_t idx_            = 0;
+        std::size_t cached_written_ = 0;
+    };
+
+public:
+    /**
+     * @param initial_segments segments allocated up front, so the first `initial_segments * segment_size` elements in
+     * flight never allocate.
+     * @param resource where segments come from, only the producer allocates so it needs no locking.
+     * It does not throw, call `successful_init()` to check the result.
+     */
+    explicit unbounded_spsc(const std::size_t initial_segments = 2,
+                            std::pmr::memory_resource *resource = std::pmr::get_default_resource()) noexcept
+        : resource_(resource)
+    {
+        segment *first = allocate_segment();
+        if (first == nullptr)
+        {
+            return;
+        }
+        producer_.tail_ = first;
+        consumer_.head_ = first;
+        for (std::size_t i = 1; i < initial_segments; i++)
+        {
+            segment *spare = allocate_segment();
+            if (spare == nullptr)
+            {
+                break;
+            }
+            spare->next_.store(producer_.spare_, std::memory_order::relaxed);
+            producer_.spare_ = spare;
+        }
+    }
+
+    ~unbounded_spsc() noexcept
+    {
+        segment *node     = consumer_.head_;
+        std::size_t begin = consumer_.idx_;
+        while (node != nullptr)
+        {
+            const std::size_t end = node->written_.load(std::memory_order::relaxed);
+            for (std::size_t i = begin; i < end; i++)
+            {
+                std::destroy_at(node->slot(i));
+            }
+            begin = 0;
+            free_segment(std::exchange(node, node->next_.load(std::memory_order::relaxed)));
+        }
+        free_chain(producer_.spare_);
+        free_chain(free_.load(std::memory_order::acquire));
+    }
+
+    unbounded_spsc(const unbounded_spsc &)            = delete;
+    unbounded_spsc &operator=(const unbounded_spsc &) = delete;
+    unbounded_spsc(unbounded_spsc &&)                 = delete;
+    unbounded_spsc &operator=(unbounded_spsc &&)      = delete;
+
+    [[nodiscard]] bool successful_init() const noexcept
+    {
+        return consumer_.head_ != nullptr;
+    }
+
+    /*
+     * never waits for the consumer. Only fails when a new segment was needed and the resource couldn't provide one.
+     */
+    template <typename... Args>
+    bool emplace(Args &&...args) noexcept(std::is_nothrow_constructible_v<T, Args &&...>)
+    {
+        if (producer_.idx_ == segment_size && !advance_tail()) [[unlikely]]
+        {
+            return false;
+        }
+        std::construct_at(producer_.tail_->slot(producer_.idx_), std::forward<Args>(args)...);
+        producer_.tail_->written_.store(++producer_.idx_, std::memory_order::release);
+        return true;
+    }
+
+    bool put(T &&element) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        return emplace(std::move(element));
+    }
+
+    bool put(const T &element) noexcept(std::is_nothrow_copy_constructible_v<T>)
+    {
+        return emplace(element);
+    }
+
+    std::optional<T> try_read() noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (consumer_.idx_ == segment_size)
+        {
+            // a segment is only ever left once the producer filled it and moved on
+            segment *next = consumer_.head_->next_.load(std::memory_order::acquire);
+            if (next == nullptr)
+            {
+                return {};
+            }
+            recycle(std::exchange(consumer_.head_, next));
+            consumer_.idx_            = 0;
+            consumer_.cached_written_ = 0;
+        }
+        if (consumer_.idx_ == consumer_.cached_written_)
+        {
+            consumer_.cached_written_ = consumer_.head_->written_.load(std::memory_order::acquire);
+            if (consumer_.idx_ == consumer_.cached_written_)
+            {
+                return {};
+            }
+        }
+
+        T *slot = consumer_.head_->slot(consumer_.idx_++);
+        std::optional<T> element(std::move(*slot));
+        std::destroy_at(slot);
+        return element;
+    }
+
+    /*
+     * spin here and busy wait to remove latency.
+     */
+    [[nodiscard]] T read() noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        while (true)
+        {
+            if (std::optional<T> element = try_read())
+            {
+                return std::move(*element);
+            }
+        }
+    }
+
+    /*
+     * consumer side check.
+     */
+    [[nodiscard]] bool empty() const noexcept
+    {
+        const segment *head = consumer_.head_;
+        if (consumer_.idx_ < segment_size)
+        {
+            return consumer_.idx_ == head->written_.load(std::memory_order::acquire);
+        }
+        const segment *next = head->next_.load(std::memory_order::acquire);
+        return next == nullptr || next->written_.load(std::memory_order::acquire) == 0;
+    }
+
+    /*
+     * segments allocated so far, i.e. the memory the queue holds is segments() * sizeof(segment).
+     */
+    [[nodiscard]] std::size_t segments() const noexcept
+    {
+        return segments_.load(std::memory_order::relaxed);
+    }
+
+    static constexpr std::size_t segment_bytes = sizeof(segment);
+
+private:
+    bool advance_tail() noexcept
+    {
+        segment *next = take_spare();
+        if (next == nullptr)
+        {
+            next = allocate_segment();
+            if (next == nullptr)
+            {
+                return false;
+            }
+        }
+        producer_.tail_->next_.store(next, std::memory_order::release);
+        producer_.tail_ = next;
+        producer_.idx_  = 0;
+        return true;
+    }
+
+    segment *take_spare() noexcept
+    {
+        if (producer_.spare_ == nullptr)
+        {
+            // take everything the consumer handed back in one go, a lone taker can't suffer ABA
+            producer_.spare_ = free_.exchange(nullptr, std::memory_order::acquire);
+            if (producer_.spare_ == nullptr)
+            {
+                return nullptr;
+            }
+        }
+        segment *spare   = producer_.spare_;
+        producer_.spare_ = spare->next_.load(std::memory_order::relaxed);
+        spare->written_.store(0, std::memory_order::relaxed);
+        spare->next_.store(nullptr, std::memory_order::relaxed);
+        return spare;
+    }
+
+    void recycle(segment *drained) noexcept
+    {
+        segment *head = free_.load(std::memory_order::relaxed);
+        do
+        {
+            drained->next_.store(head, std::memory_order::relaxed);
+        } while (!free_.compare_exchange_weak(head, drained, std::memory_order::release, std::memory_order::relaxed));
+    }
+
+    segment *allocate_segment() noexcept
+    {
+        void *memory = nullptr;
+        try
+        {
+            memory = resource_->allocate(sizeof(segment), alignof(segment));
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+        // arenas like base_allocator report exhaustion with nullptr instead of throwing
+        if (memory == nullptr)
+        {
+            return nullptr;
+        }
+        segments_.store(segments_.load(std::memory_order::relaxed) + 1, std::memory_order::relaxed);
+        return std::construct_at(static_cast<segment *>(memory));
+    }
+
+    void free_segment(segment *node) noexcept
+    {
+        std::destroy_at(node);
+        resource_->deallocate(node, sizeof(segment), alignof(segment));
+    }
+
+    void free_chain(segment *node) noexcept
+    {
+        while (node != nullptr)
+        {
+            free_segment(std::exchange(node, node->next_.load(std::memory_order::relaxed)));
+        }
+    }
+
+    alignas(std::hardware_destructive_interference_size) producer_side producer_;
+    std::atomic<std::size_t> segments_ = 0;
+    alignas(std::hardware_destructive_interference_size) consumer_side consumer_;
+    alignas(std::hardware_destructive_interference_size) std::atomic<segment *> free_ = nullptr;
+    std::pmr::memory_resource *resource_;
+};
+
+} // namespace jc::lockfree
+
+#endif
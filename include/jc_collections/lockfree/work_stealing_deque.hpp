@@ -0,0 +1,135 @@
+#ifndef JC_WORK_STEALING_DEQUE_H
+#define JC_WORK_STEALING_DEQUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+#include <jc_collections/lockfree/spsc.hpp>
+
+namespace jc::lockfree
+{
+
+/*
+ * Bounded Chase-Lev work-stealing deque, using the C11 orderings from Le et al. "Correct and Efficient Work-Stealing
+ * for Weak Memory Models". The owning thread pushes and pops at the bottom in LIFO order, any number of thieves steal
+ * from the top in FIFO order. Only the last element is ever contended between the owner and thieves.
+ *
+ * The buffer is fixed size like the rest of the queues in the library, push returns false when it is full so the
+ * owner can run the work inline instead. Elements live in atomics, so T must be trivially copyable; in practice it is
+ * a pointer to a task.
+ */
+template <typename T, std::size_t sz = 1024>
+    requires is_power_of_two<sz> && std::is_trivially_copyable_v<T>
+class work_stealing_deque
+{
+private:
+    static constexpr std::int64_t mask = sz - 1;
+
+    alignas(std::hardware_destructive_interference_size) std::atomic<std::int64_t> top_ = 0;
+    alignas(std::hardware_destructive_interference_size) std::atomic<std::int64_t> bottom_ = 0;
+    alignas(std::hardware_destructive_interference_size) std::array<std::atomic<T>, sz> items_;
+
+public:
+    work_stealing_deque() = default;
+
+    work_stealing_deque(const work_stealing_deque &)            = delete;
+    work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+    work_stealing_deque(work_stealing_deque &&)                 = delete;
+    work_stealing_deque &operator=(work_stealing_deque &&)      = delete;
+
+    /*
+     * owner only.
+     */
+    bool push(const T element) noexcept
+    {
+        const std::int64_t bottom = bottom_.load(std::memory_order::relaxed);
+        const std::int64_t top    = top_.load(std::memory_order::acquire);
+        if (bottom - top >= static_cast<std::int64_t>(sz))
+        {
+            return false;
+        }
+
+        items_[bottom & mask].store(element, std::memory_order::relaxed);
+        // a release store rather than the paper's release fence, same code on x86 and visible to tsan
+        bottom_.store(bottom + 1, std::memory_order::release);
+        return true;
+    }
+
+    /*
+     * owner only, takes the most recently pushed element.
+     */
+    std::optional<T> pop() noexcept
+    {
+        const std::int64_t bottom = bottom_.load(std::memory_order::relaxed) - 1;
+        bottom_.store(bottom, std::memory_order::relaxed);
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        std::int64_t top = top_.load(std::memory_order::relaxed);
+
+        if (top > bottom)
+        {
+            // empty, undo the reservation
+            bottom_.store(bottom + 1, std::memory_order::relaxed);
+            return {};
+        }
+
+        T element = items_[bottom & mask].load(std::memory_order::relaxed);
+        if (top == bottom)
+        {
+            // last element, race any thief for it
+            const bool won =
+                top_.compare_exchange_strong(top, top + 1, std::memory_order::seq_cst, std::memory_order::relaxed);
+            bottom_.store(bottom + 1, std::memory_order::relaxed);
+            if (!won)
+            {
+                return {};
+            }
+        }
+        return element;
+    }
+
+    /*
+     * any thread, takes the oldest element. An empty result means the deque was empty or another thread won the race.
+     */
+    std::optional<T> steal() noexcept
+    {
+        std::int64_t top = top_.load(std::memory_order::acquire);
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        const std::int64_t bottom = bottom_.load(std::memory_order::acquire);
+
+        if (top >= bottom)
+        {
+            return {};
+        }
+
+        T element = items_[top & mask].load(std::memory_order::relaxed);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order::seq_cst, std::memory_order::relaxed))
+        {
+            return {};
+        }
+        return element;
+    }
+
+    /*
+     * a snapshot, only exact when called by the owner with no thieves around.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        const std::int64_t bottom = bottom_.load(std::memory_order::relaxed);
+        const std::int64_t top    = top_.load(std::memory_order::relaxed);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+};
+
+} // namespace jc::lockfree
+
+#endif
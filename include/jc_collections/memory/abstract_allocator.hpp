@@ -1,55 +1,278 @@
 #ifndef ABSTRACT_ALLOC_H
 #define ABSTRACT_ALLOC_H
+#include <bit>
+#include <concepts>
+#include <cstddef>
 #include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
 
 namespace jc::memory
 {
 
 /**
- * @brief For internal use to abstract over a std::allocator or a pmr::memory_resource
+ * @brief A polymorphic resource, e.g. `base_allocator` or anything from `std::pmr`.
+ */
+template <typename A>
+concept pmr_resource = std::is_base_of_v<std::pmr::memory_resource, std::remove_cvref_t<A>>;
+
+/**
+ * @brief Something usable through `std::allocator_traits`, e.g. `std::allocator<T>`.
+ */
+template <typename A>
+concept standard_allocator = !pmr_resource<A> && requires(A &a, typename A::value_type *p, std::size_t n) {
+    typename A::value_type;
+    { a.allocate(n) };
+    a.deallocate(p, n);
+};
+
+/**
+ * @brief One of the library's typed, non-copyable allocators such as `cached_pool_allocator`. They hand out `T *`
+ * directly and report failure with nullptr instead of throwing.
+ */
+template <typename A, typename T>
+concept library_allocator = !pmr_resource<A> && !standard_allocator<A> && requires(A &a, T *p, std::size_t n) {
+    { a.allocate(n) } noexcept -> std::same_as<T *>;
+    { a.deallocate(p, n) } noexcept;
+};
+
+/**
+ * @brief For internal use to abstract over a std allocator, a pmr::memory_resource or one of the library's allocators.
+ *
+ * Dispatch is resolved at compile time so every call is a direct call into the upstream. Resources and library
+ * allocators are referenced (they own state and can't be copied), std allocators are held by value and stateless ones
+ * take no space thanks to [[no_unique_address]].
+ *
+ * Like the rest of the library this never throws: an upstream that reports failure by throwing is caught and turned
+ * into nullptr.
  */
 template <typename Allocator, typename T>
+    requires pmr_resource<Allocator> || standard_allocator<Allocator> || library_allocator<Allocator, T>
 class abstract_allocator
 {
+private:
+    static constexpr bool is_resource = pmr_resource<Allocator>;
+    static constexpr bool is_standard = standard_allocator<Allocator>;
+
+    template <typename A, bool standard = standard_allocator<A>>
+    struct rebound
+    {
+        using type = std::remove_cvref_t<A> *;
+    };
+
+    template <typename A>
+    struct rebound<A, true>
+    {
+        using type = typename std::allocator_traits<A>::template rebind_alloc<T>;
+    };
+
+    // a std allocator rebound to T, otherwise a pointer to the resource or library allocator
+    using storage_type = typename rebound<Allocator>::type;
+
+    template <std::size_t alignment>
+    struct alignas(alignment) aligned_block
+    {
+        std::byte bytes_[alignment];
+    };
+
 public:
-    explicit abstract_allocator(Allocator *underlying) noexcept : underlying_allocator_(underlying)
+    using value_type = T;
+
+    /**
+     * @brief References `underlying`, which must outlive this adapter. A std allocator is copied instead.
+     */
+    explicit abstract_allocator(Allocator &underlying) noexcept
+        : underlying_allocator_(make_storage(underlying))
+    {
+    }
+
+    abstract_allocator() noexcept
+        requires is_standard && std::is_nothrow_default_constructible_v<storage_type>
+    = default;
+
+    /**
+     * @brief Space for `n` objects aligned for T, or nullptr.
+     */
+    [[nodiscard]] T *allocate(const std::size_t n) noexcept
+    {
+        if constexpr (is_resource)
+        {
+            return static_cast<T *>(allocate_bytes(n * sizeof(T), alignof(T)));
+        }
+        else if constexpr (is_standard)
+        {
+            try
+            {
+                return std::to_address(std::allocator_traits<storage_type>::allocate(underlying_allocator_, n));
+            }
+            catch (...)
+            {
+                return nullptr;
+            }
+        }
+        else
+        {
+            return underlying_allocator_->allocate(n);
+        }
+    }
+
+    /**
+     * @brief Sized deallocation, `n` must match the allocate() call.
+     */
+    void deallocate(T *ptr, const std::size_t n) noexcept
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+        if constexpr (is_resource)
+        {
+            underlying_allocator_->deallocate(static_cast<void *>(ptr), n * sizeof(T), alignof(T));
+        }
+        else if constexpr (is_standard)
+        {
+            std::allocator_traits<storage_type>::deallocate(underlying_allocator_, ptr, n);
+        }
+        else
+        {
+            underlying_allocator_->deallocate(ptr, n);
+        }
+    }
+
+    /**
+     * @brief Space for `n` objects aligned to `alignment`, which may exceed alignof(T). std allocators get there by
+     * allocating whole over-aligned blocks, library allocators only ever align for T.
+     */
+    template <std::size_t alignment>
+        requires(std::has_single_bit(alignment) && alignment >= alignof(T)) &&
+                (pmr_resource<Allocator> || standard_allocator<Allocator> || alignment == alignof(T))
+    [[nodiscard]] T *allocate_aligned(const std::size_t n) noexcept
     {
+        if constexpr (is_resource)
+        {
+            return static_cast<T *>(allocate_bytes(n * sizeof(T), alignment));
+        }
+        else if constexpr (is_standard)
+        {
+            using block_allocator = typename std::allocator_traits<storage_type>::template rebind_alloc<
+                aligned_block<alignment>>;
+            block_allocator blocks(underlying_allocator_);
+            try
+            {
+                return reinterpret_cast<T *>(std::to_address(
+                    std::allocator_traits<block_allocator>::allocate(blocks, blocks_for<alignment>(n))));
+            }
+            catch (...)
+            {
+                return nullptr;
+            }
+        }
+        else
+        {
+            return underlying_allocator_->allocate(n);
+        }
     }
 
-    [[nodiscard]] T *allocate(size_t n)
+    template <std::size_t alignment>
+        requires(std::has_single_bit(alignment) && alignment >= alignof(T)) &&
+                (pmr_resource<Allocator> || standard_allocator<Allocator> || alignment == alignof(T))
+    void deallocate_aligned(T *ptr, const std::size_t n) noexcept
     {
-        if constexpr (is_memory_resource())
+        if (ptr == nullptr)
+        {
+            return;
+        }
+        if constexpr (is_resource)
+        {
+            underlying_allocator_->deallocate(static_cast<void *>(ptr), n * sizeof(T), alignment);
+        }
+        else if constexpr (is_standard)
         {
-            constexpr size_t bytes = n * sizeof(T);
-            constexpr size_t alignment = alignof(T);
-            return static_cast<T*>(underlying_allocator_.allocate(bytes, alignment));
+            using block_allocator = typename std::allocator_traits<storage_type>::template rebind_alloc<
+                aligned_block<alignment>>;
+            block_allocator blocks(underlying_allocator_);
+            std::allocator_traits<block_allocator>::deallocate(
+                blocks, reinterpret_cast<aligned_block<alignment> *>(ptr), blocks_for<alignment>(n));
         }
-        else // todo: investigate concept that identifies type of allocator
+        else
         {
-            using traits = std::allocator_traits<Allocator>;
-            return traits::allocate(underlying_allocator_, n);
+            underlying_allocator_->deallocate(ptr, n);
         }
     }
 
-    void deallocate(T *ptr, size_t n)
+    /**
+     * @brief Fills `out` with separate allocations of `n` objects each, using the upstream's own bulk entry point when
+     * it has one.
+     * @return how many were allocated, the rest of `out` is left untouched.
+     */
+    std::size_t allocate_bulk(std::span<T *> out, const std::size_t n) noexcept
     {
-        if constexpr (is_memory_resource())
+        if constexpr (requires { underlying_allocator_->allocate_bulk(out, n); })
         {
-            constexpr size_t length = n * sizeof(T);
-            constexpr size_t alignment = alignof(T);
-            underlying_allocator_.deallocate(static_cast<void *>(ptr), length, alignment);
-        } else // todo: investigate concept that identifies type of allocator
+            return underlying_allocator_->allocate_bulk(out, n);
+        }
+        else
         {
-            std::allocator_traits<Allocator>::deallocate(underlying_allocator_, ptr, n);
+            for (std::size_t i = 0; i < out.size(); i++)
+            {
+                out[i] = allocate(n);
+                if (out[i] == nullptr)
+                {
+                    return i;
+                }
+            }
+            return out.size();
+        }
+    }
+
+    void deallocate_bulk(std::span<T *const> pointers, const std::size_t n) noexcept
+    {
+        if constexpr (requires { underlying_allocator_->deallocate_bulk(pointers, n); })
+        {
+            underlying_allocator_->deallocate_bulk(pointers, n);
+        }
+        else
+        {
+            for (T *ptr : pointers)
+            {
+                deallocate(ptr, n);
+            }
         }
     }
 
 private:
-    Allocator &underlying_allocator_;
-    static constexpr bool is_memory_resource()
+    static storage_type make_storage(Allocator &underlying) noexcept
     {
-        return std::is_base_of_v<std::pmr::memory_resource, std::remove_cvref_t<Allocator>>;
+        if constexpr (is_standard)
+        {
+            return storage_type(underlying);
+        }
+        else
+        {
+            return &underlying;
+        }
     }
+
+    template <std::size_t alignment>
+    static constexpr std::size_t blocks_for(const std::size_t n) noexcept
+    {
+        return (n * sizeof(T) + alignment - 1) / alignment;
+    }
+
+    void *allocate_bytes(const std::size_t bytes, const std::size_t alignment) noexcept
+    {
+        try
+        {
+            return underlying_allocator_->allocate(bytes, alignment);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    [[no_unique_address]] storage_type underlying_allocator_{};
 };
 
 } // namespace jc::memory
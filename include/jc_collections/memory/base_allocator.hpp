@@ -5,8 +5,38 @@
 #include <memory>
 #include <memory_resource>
 #include <sys/mman.h>
+#include <unistd.h>
+
+#include <jc_collections/util.h>
 namespace jc::memory
 {
+/**
+ * @brief When the pages backing an arena become usable.
+ *
+ * `eager` maps the whole capacity read/write up front, the kernel still only backs pages once they are touched.
+ * `lazy` only reserves address space (PROT_NONE, no swap reservation) and makes it accessible chunk by chunk as the
+ * bump pointer advances, so a large reservation costs neither commit charge nor page tables until it is used.
+ */
+enum class commit_mode : u8
+{
+    eager,
+    lazy,
+};
+
+/**
+ * @brief How decommitted pages are handed back to the OS.
+ *
+ * `dont_need` drops them immediately (RSS falls at once and they read back as zero). `free` lets the kernel reclaim
+ * them whenever it is under memory pressure, which is cheaper when the arena is likely to be refilled soon but leaves
+ * RSS high until then. Pages decommitted from a lazy arena always use `dont_need`, since they are also made
+ * inaccessible again.
+ */
+enum class release_mode : u8
+{
+    dont_need,
+    free,
+};
+
 /**
  * @brief A simple arena allocator using mmap.
  *
@@ -15,6 +45,9 @@ namespace jc::memory
  * The entire memory block is released when the allocator is destroyed.
  * It is designed to be used as a std::pmr::memory_resource.
  *
+ * Long running owners can rewind it with `reset()` and return the pages a burst touched with `decommit()` or
+ * `reset_and_trim()`, otherwise every page the arena ever touched stays resident until it is destroyed.
+ *
  * Note: This implementation is NOT thread-safe. Access from multiple threads
  * requires external synchronization.
  */
@@ -24,12 +57,18 @@ public:
     /**
      * @brief Constructs the allocator and reserves memory.
      * @param capacity The total number of bytes to reserve using mmap.
+     * @param mode Whether the whole capacity is usable at once or committed as the arena grows.
+     * @param commit_chunk In lazy mode, how many bytes to commit at a time, rounded up to whole pages.
      * It does not throw on unsuccessful initiation, instead call the `successful_init()` function
      */
-    explicit base_allocator(const size_t capacity) noexcept : capacity_(capacity)
+    explicit base_allocator(const size_t capacity, const commit_mode mode = commit_mode::eager,
+                            const size_t commit_chunk = default_commit_chunk) noexcept
+        : capacity_(capacity), mode_(mode)
     {
-        current_ptr_ = mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
-        base_ptr     = current_ptr_;
+        const int protection = mode_ == commit_mode::lazy ? PROT_NONE : PROT_READ | PROT_WRITE;
+        const int flags      = MAP_ANONYMOUS | MAP_PRIVATE | (mode_ == commit_mode::lazy ? MAP_NORESERVE : 0);
+        current_ptr_         = mmap(nullptr, capacity_, protection, flags, -1, 0);
+        base_ptr             = current_ptr_;
 
         if (current_ptr_ == MAP_FAILED)
         {
@@ -37,6 +76,8 @@ public:
             current_ptr_ = nullptr;
             capacity_    = 0;
         }
+        commit_chunk_ = round_to_page(commit_chunk == 0 ? 1 : commit_chunk);
+        committed_    = mode_ == commit_mode::lazy ? 0 : capacity_;
     }
     /**
      * @brief Deallocates all memory associated here and releases mapped memory
@@ -80,7 +121,7 @@ public:
      */
     std::size_t used() const noexcept
     {
-        return static_cast<std::size_t>(current_ptr_ - base_ptr);
+        return static_cast<std::size_t>(static_cast<std::byte *>(current_ptr_) - static_cast<std::byte *>(base_ptr));
     }
 
     /**
@@ -92,6 +133,64 @@ public:
         return capacity() - used();
     }
 
+    /**
+     * @brief Gets the number of bytes that are currently accessible, the whole capacity unless the arena is lazy.
+     * @return number of committed bytes.
+     */
+    std::size_t committed() const noexcept
+    {
+        return committed_;
+    }
+
+    /**
+     * @brief Rewinds the bump pointer, everything allocated so far becomes invalid. Pages stay resident.
+     */
+    void reset() noexcept
+    {
+        current_ptr_ = base_ptr;
+    }
+
+    /**
+     * @brief Returns the pages from byte offset `from` to the end of the arena to the OS.
+     *
+     * `from` is rounded up to a page and never goes below `used()`, so live allocations are not touched. With
+     * `release_mode::dont_need`, and always in lazy mode, decommitted memory reads back as zero the next time it is
+     * handed out. With `release_mode::free` on an eager arena the kernel only takes the pages when it needs memory,
+     * until then they keep their old contents, so don't count on zeroes.
+     * @return false if there was nothing to release or the kernel refused.
+     */
+    bool decommit(const std::size_t from, const release_mode release = release_mode::dont_need) noexcept
+    {
+        const std::size_t start = round_to_page(from > used() ? from : used());
+        if (start >= committed_)
+        {
+            return false;
+        }
+        std::byte *begin       = static_cast<std::byte *>(base_ptr) + start;
+        const std::size_t size = committed_ - start;
+        if (mode_ == commit_mode::lazy)
+        {
+            // dropping the pages before protecting them again is what actually gives them back
+            if (madvise(begin, size, MADV_DONTNEED) != 0 || mprotect(begin, size, PROT_NONE) != 0)
+            {
+                return false;
+            }
+            committed_ = start;
+            return true;
+        }
+        return madvise(begin, size, release == release_mode::free ? MADV_FREE : MADV_DONTNEED) == 0;
+    }
+
+    /**
+     * @brief `reset()` followed by `decommit(keep)`: the first `keep` bytes stay resident for the next burst and
+     * everything past them goes back to the OS.
+     */
+    bool reset_and_trim(const std::size_t keep = 0, const release_mode release = release_mode::dont_need) noexcept
+    {
+        reset();
+        return decommit(keep, release);
+    }
+
 private:
     /**
      * @brief Allocates memory with specified size and alignment.
@@ -116,14 +215,45 @@ private:
         const std::size_t current_ptr_used =
             static_cast<std::byte *>(current_ptr_) - static_cast<std::byte *>(base_ptr);
         std::size_t remaining = capacity_ > current_ptr_used ? capacity_ - current_ptr_used : 0;
-        const auto ptr        = std::align(alignment, bytes, current_ptr_, remaining);
-        if (ptr)
+        void *aligned         = current_ptr_;
+        const auto ptr        = std::align(alignment, bytes, aligned, remaining);
+        if (ptr == nullptr)
         {
-            current_ptr_ = static_cast<std::byte *>(current_ptr_) + bytes;
+            return nullptr;
         }
+        const std::size_t end = static_cast<std::size_t>(static_cast<std::byte *>(ptr) + bytes -
+                                                         static_cast<std::byte *>(base_ptr));
+        if (end > committed_ && !commit_to(end)) [[unlikely]]
+        {
+            return nullptr;
+        }
+        current_ptr_ = static_cast<std::byte *>(ptr) + bytes;
         return ptr;
     }
 
+    /**
+     * @brief Makes the arena accessible up to at least `end`, a chunk at a time, capped at the capacity.
+     * @return false if mprotect failed, e.g. the process is out of commit charge.
+     */
+    bool commit_to(const std::size_t end) noexcept
+    {
+        std::size_t target = (end + commit_chunk_ - 1) / commit_chunk_ * commit_chunk_;
+        target             = target < capacity_ ? target : round_to_page(capacity_);
+        if (mprotect(static_cast<std::byte *>(base_ptr) + committed_, target - committed_, PROT_READ | PROT_WRITE) !=
+            0)
+        {
+            return false;
+        }
+        committed_ = target;
+        return true;
+    }
+
+    static std::size_t round_to_page(const std::size_t bytes) noexcept
+    {
+        static const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return (bytes + page - 1) / page * page;
+    }
+
     /**
      * @brief Deallocates memory (no-op for arena).
      *
@@ -156,9 +286,14 @@ private:
         return this == &other;
     }
 
-    void *current_ptr_    = nullptr;
-    void *base_ptr        = nullptr;
-    std::size_t capacity_ = 0;
+    static constexpr std::size_t default_commit_chunk = 2 << 20;
+
+    void *current_ptr_        = nullptr;
+    void *base_ptr            = nullptr;
+    std::size_t capacity_     = 0;
+    std::size_t committed_    = 0;
+    std::size_t commit_chunk_ = 0;
+    commit_mode mode_         = commit_mode::eager;
 };
 } // namespace jc::memory
 
@@ -8,6 +8,12 @@
 namespace jc::memory
 {
 
+/**
+ * @brief Hands out runs of up to 256 `T`s from pools of 256, a pool is reused once everything taken from it is back.
+ *
+ * The `amount` items are drawn from `Allocator` once, at construction, and given back on destruction. It does not
+ * throw, call `successful_init()` to check the upstream could provide them; until then every allocate() fails.
+ */
 template <typename T, size_t amount, typename Allocator>
 class cached_pool_allocator
 {
@@ -24,21 +30,38 @@ public:
     using size_type          = size_t;
     using difference_type    = ptrdiff_t;
 
-    explicit cached_pool_allocator(Allocator &allocator) noexcept : allocator_(allocator)
+    explicit cached_pool_allocator(Allocator &allocator) noexcept
+        : allocator_(allocator), items_(allocator_.allocate(amount))
     {
         current_bit_ = static_cast<size_t>(bits_.get_and_set());
     }
 
     ~cached_pool_allocator()
     {
+        allocator_.deallocate(items_, amount);
+    }
+
+    // the items are owned by this object, copying would lead to a double free
+    cached_pool_allocator(const cached_pool_allocator &)            = delete;
+    cached_pool_allocator &operator=(const cached_pool_allocator &) = delete;
+    cached_pool_allocator(cached_pool_allocator &&)                 = delete;
+    cached_pool_allocator &operator=(cached_pool_allocator &&)      = delete;
+
+    [[nodiscard]] bool successful_init() const noexcept
+    {
+        return items_ != nullptr;
     }
 
     T *allocate(const size_t n) noexcept
     // only dealing with one allocation and deallocation atm
     {
-        assert(n <= 256, "this allocator only supports allocations up to 256");
-        assert(n > 0, "allocation amount must be positive");
-        if (pool_allocation_count_[current_bit_] <= 256 - n)
+        assert(n <= 256 && "this allocator only supports allocations up to 256");
+        assert(n > 0 && "allocation amount must be positive");
+        if (items_ == nullptr) [[unlikely]]
+        {
+            return nullptr;
+        }
+        if (pool_allocation_count_[current_bit_] + n <= pool_size(current_bit_))
         {
             const size_t idx = (current_bit_ * 256) + pool_allocation_count_[current_bit_];
             pool_allocation_count_[current_bit_] += n;
@@ -52,6 +75,12 @@ public:
             {
                 return nullptr;
             }
+            if (n > pool_size(static_cast<size_t>(index))) [[unlikely]]
+            {
+                // only the trailing pool can be short, hand it back and fail
+                bits_.unset_bit(static_cast<size_t>(index));
+                return nullptr;
+            }
             current_bit_                         = static_cast<size_t>(index);
             const pointer ptr                    = &items_[current_bit_ * 256];
             pool_allocation_count_[current_bit_] = n;
@@ -64,14 +93,14 @@ public:
         {
             return;
         }
-        assert(n <= 256, "max allocation/deallocation is 256");
-        assert(p >= items_ && (p + n) <= (items_ + amount), "Pointer out of bounds!");
+        assert(n <= 256 && "max allocation/deallocation is 256");
+        assert(p >= items_ && (p + n) <= (items_ + amount) && "Pointer out of bounds!");
 
         const ptrdiff_t offset = p - items_;
 
         const size_t index = static_cast<size_t>(offset) >> 8;
 
-        pool_free_count_[index] += static_cast<u8>(n);
+        pool_free_count_[index] += static_cast<u16>(n);
         if (current_bit_ == index && pool_free_count_[index] == pool_allocation_count_[index]) [[unlikely]]
         {
             pool_free_count_[index]       = 0;
@@ -92,15 +121,21 @@ private:
         // each bit is a representation of 256
         return int_ceil(amount, 256);
     }
+    static constexpr size_t pool_size(const size_t index)
+    {
+        // every pool holds 256 items except the last one when amount isn't a multiple of 256
+        return amount - (index * 256) < 256 ? amount - (index * 256) : 256;
+    }
     size_t current_bit_ = 0;
     // tracks which pools are "in use"
-    collections::scalar_bitset<bitset_item_count(bitset_item_count())> bits_;
+    collections::scalar_bitset<bitset_item_count()> bits_;
     // increment this when an item is used from a pool
-    u8 pool_allocation_count_[bitset_item_count()] = {0};
+    // u16 since a full pool holds 256 items, one more than a u8 can count
+    u16 pool_allocation_count_[bitset_item_count()] = {0};
     // increment this when an item is returned to a pool (when free count == allocation count, the pool is empty)
-    u8 pool_free_count_[bitset_item_count()] = {0};
-    T items_[amount];
+    u16 pool_free_count_[bitset_item_count()] = {0};
     abstract_allocator<Allocator, T> allocator_;
+    T *items_;
 };
 } // namespace jc::memory
 
@@ -0,0 +1,111 @@
+#ifndef JC_FIXED_ARENA_H
+#define JC_FIXED_ARENA_H
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include <jc_collections/util.h>
+namespace jc::memory
+{
+/**
+ * @brief A bump allocator over an inline buffer of `capacity` elements, usable in constant expressions.
+ *
+ * The typed counterpart of `base_allocator` for tables that are built at compile time: constexpr code can't hand out
+ * raw bytes, so the buffer is an array of `T` and allocations are runs of its elements. An arena built in a constexpr
+ * initializer is a literal like any other and ends up in `.rodata`.
+ *
+ * Only the last allocation can be given back, `reset()` rewinds the whole buffer. Nothing is stored as a pointer, so
+ * copies are independent and can be returned from constexpr functions.
+ *
+ * Note: This implementation is NOT thread-safe.
+ */
+template <typename T, std::size_t capacity_>
+    requires std::is_default_constructible_v<T> && std::is_trivially_destructible_v<T>
+class fixed_arena
+{
+public:
+    /**
+     * @brief Hands out the next `n` elements.
+     * @return the first of them, or nullptr if the buffer doesn't have `n` left. Dereferencing that nullptr is what
+     * turns an overflow during constant evaluation into a compile error.
+     */
+    constexpr T *allocate(const std::size_t n) noexcept
+    {
+        if (n > capacity_ - used_)
+        {
+            return nullptr;
+        }
+        T *block = slots_.data() + used_;
+        used_ += n;
+        return block;
+    }
+
+    /**
+     * @brief Gives the block back if it is the last one handed out, otherwise a no-op.
+     */
+    constexpr void deallocate(T *block, const std::size_t n) noexcept
+    {
+        if (n <= used_ && block == slots_.data() + (used_ - n))
+        {
+            used_ -= n;
+        }
+    }
+
+    /**
+     * @brief Rewinds the bump pointer, everything allocated so far becomes invalid.
+     */
+    constexpr void reset() noexcept
+    {
+        used_ = 0;
+    }
+
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept
+    {
+        return capacity_;
+    }
+
+    [[nodiscard]] constexpr std::size_t used() const noexcept
+    {
+        return used_;
+    }
+
+    [[nodiscard]] constexpr std::size_t remaining() const noexcept
+    {
+        return capacity_ - used_;
+    }
+
+    /**
+     * @brief The start of the buffer, allocations are consecutive runs from here.
+     */
+    [[nodiscard]] constexpr T *data() noexcept
+    {
+        return slots_.data();
+    }
+
+    [[nodiscard]] constexpr const T *data() const noexcept
+    {
+        return slots_.data();
+    }
+
+    /**
+     * @brief Everything allocated so far, in allocation order.
+     */
+    [[nodiscard]] constexpr std::span<T> allocated() noexcept
+    {
+        return {slots_.data(), used_};
+    }
+
+    [[nodiscard]] constexpr std::span<const T> allocated() const noexcept
+    {
+        return {slots_.data(), used_};
+    }
+
+private:
+    std::array<T, capacity_> slots_{};
+    std::size_t used_ = 0;
+};
+} // namespace jc::memory
+
+#endif
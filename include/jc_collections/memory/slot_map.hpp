@@ -0,0 +1,557 @@
+#ifndef JC_SLOT_MAP_H
+#define JC_SLOT_MAP_H
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <jc_collections/util.h>
+
+namespace jc::memory
+{
+
+/**
+ * @brief An index + generation pair packed into one unsigned word.
+ *
+ * The low `index_bits` select a slot and the remaining bits carry the slot's generation at the time the handle was
+ * issued. Freeing a slot bumps its generation, so every handle to the old occupant stops resolving, and that stays
+ * true until the generation wraps around, i.e. after 2^(generation bits) reuses of the same slot.
+ */
+template <std::unsigned_integral Word, std::size_t index_bits>
+    requires(index_bits > 0) && (index_bits < std::numeric_limits<Word>::digits)
+struct basic_handle
+{
+    using word_type = Word;
+
+    static constexpr std::size_t generation_bits = std::numeric_limits<Word>::digits - index_bits;
+    static constexpr Word index_mask             = (Word{1} << index_bits) - 1;
+    static constexpr Word generation_mask        = static_cast<Word>(~Word{0} >> index_bits);
+    // the all ones index is never handed out, so the all ones handle never resolves
+    static constexpr std::size_t max_slots = index_mask;
+
+    Word value_ = ~Word{0};
+
+    [[nodiscard]] static constexpr basic_handle make(const std::size_t index, const std::size_t generation) noexcept
+    {
+        return basic_handle{static_cast<Word>((static_cast<Word>(generation & generation_mask) << index_bits) |
+                                              (static_cast<Word>(index) & index_mask))};
+    }
+
+    [[nodiscard]] constexpr std::size_t index() const noexcept
+    {
+        return value_ & index_mask;
+    }
+
+    [[nodiscard]] constexpr std::size_t generation() const noexcept
+    {
+        return value_ >> index_bits;
+    }
+
+    [[nodiscard]] constexpr bool valid() const noexcept
+    {
+        return value_ != ~Word{0};
+    }
+
+    friend constexpr bool operator==(basic_handle, basic_handle) noexcept = default;
+};
+
+// ~1M slots with 4096 generations each
+using handle32 = basic_handle<u32, 20>;
+// 4G slots with 4G generations each
+using handle64 = basic_handle<u64, 32>;
+
+/**
+ * @brief Fixed capacity slot map: objects live densely packed in one array and are referenced through
+ * generation-checked handles.
+ *
+ * A sparse slot array maps handles to positions in the dense array and a dense-to-slot array maps back, so insert,
+ * erase and lookup are O(1), and iterating the live objects is a walk over a contiguous array. Erasing moves the last
+ * object into the hole, so pointers into the map are only stable until the next erase; handles are the stable
+ * references. Freed slots go on an intrusive free list threaded through the slot array.
+ *
+ * All three arrays come out of one allocation from a `std::pmr::memory_resource`, typically a
+ * `jc::memory::base_allocator`. Nothing throws, use `successful_init()` after construction.
+ *
+ * Note: This implementation is NOT thread-safe, see concurrent_slot_pool for the concurrent variant.
+ */
+template <typename T, typename Handle = handle64>
+    requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>
+class slot_map
+{
+private:
+    using word_type = typename Handle::word_type;
+
+    struct slot
+    {
+        // position in the dense array while live, next free slot while free
+        word_type index_or_next_;
+        word_type generation_;
+    };
+
+    static constexpr word_type end_of_list = ~word_type{0};
+
+public:
+    using handle_type = Handle;
+
+    /**
+     * @brief Allocates room for `capacity` objects from `resource`.
+     */
+    explicit slot_map(const std::size_t capacity,
+                      std::pmr::memory_resource &resource = *std::pmr::get_default_resource()) noexcept
+        : resource_(&resource), capacity_(capacity <= Handle::max_slots ? capacity : 0)
+    {
+        if (capacity_ == 0)
+        {
+            return;
+        }
+        try
+        {
+            storage_ = resource_->allocate(storage_bytes(), storage_alignment);
+        }
+        catch (...)
+        {
+            storage_ = nullptr;
+        }
+        if (storage_ == nullptr)
+        {
+            capacity_ = 0;
+            return;
+        }
+
+        dense_         = static_cast<T *>(storage_);
+        dense_to_slot_ = reinterpret_cast<word_type *>(static_cast<std::byte *>(storage_) + slots_offset());
+        slots_         = reinterpret_cast<slot *>(static_cast<std::byte *>(storage_) + sparse_offset());
+        for (std::size_t i = 0; i < capacity_; i++)
+        {
+            slots_[i] = slot{i + 1 < capacity_ ? static_cast<word_type>(i + 1) : end_of_list, 0};
+        }
+        free_head_ = 0;
+    }
+
+    ~slot_map() noexcept
+    {
+        if (storage_ == nullptr)
+        {
+            return;
+        }
+        std::destroy_n(dense_, size_);
+        resource_->deallocate(storage_, storage_bytes(), storage_alignment);
+    }
+
+    slot_map(const slot_map &)            = delete;
+    slot_map &operator=(const slot_map &) = delete;
+    slot_map(slot_map &&)                 = delete;
+    slot_map &operator=(slot_map &&)      = delete;
+
+    [[nodiscard]] bool successful_init() const noexcept
+    {
+        return storage_ != nullptr;
+    }
+
+    /**
+     * @brief Constructs an object in place.
+     * @return its handle, or an invalid handle if the map is full.
+     */
+    template <typename... Args>
+        requires std::is_nothrow_constructible_v<T, Args...>
+    Handle emplace(Args &&...args) noexcept
+    {
+        if (free_head_ == end_of_list)
+        {
+            return Handle{};
+        }
+        const word_type index = free_head_;
+        slot &entry           = slots_[index];
+        free_head_            = entry.index_or_next_;
+
+        std::construct_at(dense_ + size_, std::forward<Args>(args)...);
+        dense_to_slot_[size_] = index;
+        entry.index_or_next_  = static_cast<word_type>(size_++);
+        return Handle::make(index, entry.generation_);
+    }
+
+    /**
+     * @brief Destroys the object behind `handle`, moving the last object into its place.
+     * @return false if the handle was stale.
+     */
+    bool erase(const Handle handle) noexcept
+    {
+        slot *entry = resolve(handle);
+        if (entry == nullptr)
+        {
+            return false;
+        }
+
+        const std::size_t hole = entry->index_or_next_;
+        const std::size_t last = --size_;
+        std::destroy_at(dense_ + hole);
+        if (hole != last)
+        {
+            std::construct_at(dense_ + hole, std::move(dense_[last]));
+            std::destroy_at(dense_ + last);
+            dense_to_slot_[hole]                        = dense_to_slot_[last];
+            slots_[dense_to_slot_[hole]].index_or_next_ = static_cast<word_type>(hole);
+        }
+
+        entry->generation_    = static_cast<word_type>((entry->generation_ + 1) & Handle::generation_mask);
+        entry->index_or_next_ = free_head_;
+        free_head_            = static_cast<word_type>(handle.index());
+        return true;
+    }
+
+    /**
+     * @brief O(1) validated lookup.
+     * @return the object, or nullptr if the handle is stale or was never issued by this map.
+     */
+    [[nodiscard]] T *get(const Handle handle) noexcept
+    {
+        const slot *entry = resolve(handle);
+        return entry == nullptr ? nullptr : dense_ + entry->index_or_next_;
+    }
+
+    [[nodiscard]] const T *get(const Handle handle) const noexcept
+    {
+        return const_cast<slot_map *>(this)->get(handle);
+    }
+
+    [[nodiscard]] bool contains(const Handle handle) const noexcept
+    {
+        return get(handle) != nullptr;
+    }
+
+    /**
+     * @brief The handle of the object at dense position `position`, useful while iterating.
+     */
+    [[nodiscard]] Handle handle_at(const std::size_t position) const noexcept
+    {
+        const word_type index = dense_to_slot_[position];
+        return Handle::make(index, slots_[index].generation_);
+    }
+
+    /**
+     * @brief The live objects, contiguous and in no particular order.
+     */
+    [[nodiscard]] std::span<T> values() noexcept
+    {
+        return {dense_, size_};
+    }
+
+    [[nodiscard]] std::span<const T> values() const noexcept
+    {
+        return {dense_, size_};
+    }
+
+    [[nodiscard]] T *begin() noexcept
+    {
+        return dense_;
+    }
+
+    [[nodiscard]] T *end() noexcept
+    {
+        return dense_ + size_;
+    }
+
+    [[nodiscard]] const T *begin() const noexcept
+    {
+        return dense_;
+    }
+
+    [[nodiscard]] const T *end() const noexcept
+    {
+        return dense_ + size_;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+private:
+    static constexpr std::size_t storage_alignment = std::max(alignof(T), alignof(slot));
+
+    [[nodiscard]] std::size_t slots_offset() const noexcept
+    {
+        return int_ceil(capacity_ * sizeof(T), alignof(word_type)) * alignof(word_type);
+    }
+
+    [[nodiscard]] std::size_t sparse_offset() const noexcept
+    {
+        return int_ceil(slots_offset() + capacity_ * sizeof(word_type), alignof(slot)) * alignof(slot);
+    }
+
+    [[nodiscard]] std::size_t storage_bytes() const noexcept
+    {
+        return sparse_offset() + capacity_ * sizeof(slot);
+    }
+
+    [[nodiscard]] slot *resolve(const Handle handle) noexcept
+    {
+        const std::size_t index = handle.index();
+        if (index >= capacity_)
+        {
+            return nullptr;
+        }
+        slot &entry = slots_[index];
+        // a free slot's generation was already bumped, so a match means the slot is live unless the generation wrapped
+        // all the way around. The position check keeps even that case pointing at a live object
+        return entry.generation_ == handle.generation() && entry.index_or_next_ < size_ ? &entry : nullptr;
+    }
+
+    std::pmr::memory_resource *resource_;
+    void *storage_            = nullptr;
+    T *dense_                 = nullptr;
+    word_type *dense_to_slot_ = nullptr;
+    slot *slots_              = nullptr;
+    std::size_t size_         = 0;
+    std::size_t capacity_     = 0;
+    word_type free_head_      = end_of_list;
+};
+
+/**
+ * @brief Fixed capacity object pool with generation-checked handles that any thread may acquire from, release to and
+ * look up in without locks.
+ *
+ * Objects never move, each slot holds its object in place next to an atomic state word (generation << 1 | live).
+ * Free slots form a Treiber stack whose head carries an ABA tag in its upper half. release() claims the object with a
+ * single compare-exchange on the state, so of two threads racing to release the same handle exactly one wins, and
+ * every later lookup through that handle fails.
+ *
+ * The generation check catches stale handles, it does not keep an object alive: a thread must not release an object
+ * another thread is still using through get(). Unlike slot_map the live objects are not packed, for_each() visits them
+ * by scanning the slots.
+ */
+template <typename T, typename Handle = handle64>
+    requires std::is_nothrow_destructible_v<T>
+class concurrent_slot_pool
+{
+private:
+    static constexpr u32 end_of_list = ~u32{0};
+
+    struct alignas(std::hardware_destructive_interference_size) slot
+    {
+        std::atomic<u64> state_ = 0;
+        std::atomic<u32> next_  = end_of_list;
+        alignas(T) std::byte storage_[sizeof(T)];
+
+        T *object() noexcept
+        {
+            return std::launder(reinterpret_cast<T *>(storage_));
+        }
+    };
+
+    static constexpr u64 live = 1;
+
+    static constexpr bool same_generation(const u64 state, const std::size_t generation) noexcept
+    {
+        return ((state >> 1) & Handle::generation_mask) == generation;
+    }
+
+public:
+    using handle_type = Handle;
+
+    explicit concurrent_slot_pool(const std::size_t capacity,
+                                  std::pmr::memory_resource &resource = *std::pmr::get_default_resource()) noexcept
+        : resource_(&resource),
+          capacity_(capacity <= Handle::max_slots && capacity < end_of_list ? capacity : 0)
+    {
+        if (capacity_ == 0)
+        {
+            return;
+        }
+        try
+        {
+            slots_ = static_cast<slot *>(resource_->allocate(capacity_ * sizeof(slot), alignof(slot)));
+        }
+        catch (...)
+        {
+            slots_ = nullptr;
+        }
+        if (slots_ == nullptr)
+        {
+            capacity_ = 0;
+            return;
+        }
+        for (std::size_t i = 0; i < capacity_; i++)
+        {
+            std::construct_at(slots_ + i);
+            slots_[i].next_.store(i + 1 < capacity_ ? static_cast<u32>(i + 1) : end_of_list,
+                                  std::memory_order::relaxed);
+        }
+        free_head_.store(0, std::memory_order::release);
+    }
+
+    ~concurrent_slot_pool() noexcept
+    {
+        if (slots_ == nullptr)
+        {
+            return;
+        }
+        for (std::size_t i = 0; i < capacity_; i++)
+        {
+            if (slots_[i].state_.load(std::memory_order::relaxed) & live)
+            {
+                std::destroy_at(slots_[i].object());
+            }
+            std::destroy_at(slots_ + i);
+        }
+        resource_->deallocate(slots_, capacity_ * sizeof(slot), alignof(slot));
+    }
+
+    concurrent_slot_pool(const concurrent_slot_pool &)            = delete;
+    concurrent_slot_pool &operator=(const concurrent_slot_pool &) = delete;
+    concurrent_slot_pool(concurrent_slot_pool &&)                 = delete;
+    concurrent_slot_pool &operator=(concurrent_slot_pool &&)      = delete;
+
+    [[nodiscard]] bool successful_init() const noexcept
+    {
+        return slots_ != nullptr;
+    }
+
+    /**
+     * @brief Constructs an object in a free slot.
+     * @return its handle, or an invalid handle if the pool is exhausted.
+     */
+    template <typename... Args>
+        requires std::is_nothrow_constructible_v<T, Args...>
+    Handle acquire(Args &&...args) noexcept
+    {
+        const u32 index = pop_free();
+        if (index == end_of_list)
+        {
+            return Handle{};
+        }
+        slot &entry     = slots_[index];
+        const u64 state = entry.state_.load(std::memory_order::relaxed);
+        std::construct_at(entry.object(), std::forward<Args>(args)...);
+        entry.state_.store(state | live, std::memory_order::release);
+        return Handle::make(index, (state >> 1) & Handle::generation_mask);
+    }
+
+    /**
+     * @brief Destroys the object and recycles its slot.
+     * @return false if the handle was stale or another thread released it first.
+     */
+    bool release(const Handle handle) noexcept
+    {
+        const std::size_t index = handle.index();
+        if (index >= capacity_)
+        {
+            return false;
+        }
+        slot &entry = slots_[index];
+        u64 state   = entry.state_.load(std::memory_order::acquire);
+        if (!(state & live) || !same_generation(state, handle.generation()))
+        {
+            return false;
+        }
+        // bumping the generation and clearing live in one step retires every copy of the handle
+        if (!entry.state_.compare_exchange_strong(state, (state & ~live) + 2, std::memory_order::acq_rel,
+                                                  std::memory_order::relaxed))
+        {
+            return false;
+        }
+        std::destroy_at(entry.object());
+        push_free(static_cast<u32>(index));
+        return true;
+    }
+
+    /**
+     * @brief O(1) validated lookup, nullptr for a stale handle.
+     */
+    [[nodiscard]] T *get(const Handle handle) noexcept
+    {
+        const std::size_t index = handle.index();
+        if (index >= capacity_)
+        {
+            return nullptr;
+        }
+        slot &entry     = slots_[index];
+        const u64 state = entry.state_.load(std::memory_order::acquire);
+        return (state & live) && same_generation(state, handle.generation()) ? entry.object() : nullptr;
+    }
+
+    /**
+     * @brief Calls `f(handle, object)` for every object that is live when its slot is visited.
+     */
+    template <typename F>
+    void for_each(F &&f) noexcept(noexcept(f(std::declval<Handle>(), std::declval<T &>())))
+    {
+        for (std::size_t i = 0; i < capacity_; i++)
+        {
+            const u64 state = slots_[i].state_.load(std::memory_order::acquire);
+            if (state & live)
+            {
+                f(Handle::make(i, (state >> 1) & Handle::generation_mask), *slots_[i].object());
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+private:
+    static constexpr u64 tag_shift = 32;
+
+    u32 pop_free() noexcept
+    {
+        u64 head = free_head_.load(std::memory_order::acquire);
+        while (true)
+        {
+            const auto index = static_cast<u32>(head);
+            if (index == end_of_list)
+            {
+                return end_of_list;
+            }
+            // the tag changes on every pop, so a head that was popped and pushed back in between fails the exchange
+            const u64 tag  = ((head >> tag_shift) + 1) << tag_shift;
+            const u64 next = tag | slots_[index].next_.load(std::memory_order::relaxed);
+            if (free_head_.compare_exchange_weak(head, next, std::memory_order::acquire, std::memory_order::acquire))
+            {
+                return index;
+            }
+        }
+    }
+
+    void push_free(const u32 index) noexcept
+    {
+        u64 head = free_head_.load(std::memory_order::relaxed);
+        while (true)
+        {
+            slots_[index].next_.store(static_cast<u32>(head), std::memory_order::relaxed);
+            const u64 next = (head & ~u64{0xffffffff}) | index;
+            if (free_head_.compare_exchange_weak(head, next, std::memory_order::release, std::memory_order::relaxed))
+            {
+                return;
+            }
+        }
+    }
+
+    std::pmr::memory_resource *resource_;
+    slot *slots_          = nullptr;
+    std::size_t capacity_ = 0;
+    alignas(std::hardware_destructive_interference_size) std::atomic<u64> free_head_ = end_of_list;
+};
+
+} // namespace jc::memory
+
+#endif
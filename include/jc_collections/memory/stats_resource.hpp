@@ -0,0 +1,312 @@
+#ifndef JC_STATS_RESOURCE_H
+#define JC_STATS_RESOURCE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include <jc_collections/util.h>
+
+/*
+ * Define JC_DISABLE_MEMORY_STATS to turn every stats_resource into a plain forwarding wrapper.
+ */
+#ifdef JC_DISABLE_MEMORY_STATS
+#define JC_MEMORY_STATS_ENABLED false
+#else
+#define JC_MEMORY_STATS_ENABLED true
+#endif
+
+namespace jc::memory
+{
+
+/**
+ * @brief Point in time totals of a stats resource, summed over every thread that used it.
+ *
+ * Size class i counts requests of up to 2^(i + 4) bytes, the last class takes everything bigger. Latency bucket i
+ * counts sampled allocations that took [2^i, 2^(i + 1)) nanoseconds.
+ */
+struct memory_stats
+{
+    static constexpr std::size_t size_classes    = 18;
+    static constexpr std::size_t latency_buckets = 32;
+
+    std::array<u64, size_classes> allocations_{};
+    std::array<u64, size_classes> deallocations_{};
+    std::array<u64, latency_buckets> latency_{};
+    u64 allocated_bytes_   = 0;
+    u64 deallocated_bytes_ = 0;
+    u64 failures_          = 0;
+    // peak of what any single thread had outstanding, and of the resource wide total as seen by snapshots
+    i64 thread_high_water_ = 0;
+    i64 high_water_        = 0;
+
+    [[nodiscard]] i64 live_bytes() const noexcept
+    {
+        return static_cast<i64>(allocated_bytes_ - deallocated_bytes_);
+    }
+
+    /**
+     * @brief Allocations of a size class that have not been given back yet, i.e. leaks if the owner is finished.
+     */
+    [[nodiscard]] i64 outstanding(const std::size_t size_class) const noexcept
+    {
+        return static_cast<i64>(allocations_[size_class] - deallocations_[size_class]);
+    }
+};
+
+/**
+ * @brief A `std::pmr::memory_resource` decorator that forwards to an upstream resource and records what went through
+ * it: per size class allocation and deallocation counts, bytes live, high-water marks, allocation latency and
+ * failures.
+ *
+ * Counters are thread local, every thread that touches the resource gets its own block (allocated once, from the
+ * global heap so stats never recurse into the upstream) and only ever does plain relaxed stores to it, so the hot
+ * path has no shared writes. snapshot() sums the blocks. Timing an allocation costs two clock reads, so only one in
+ * `sample_every` allocations is timed; the counts and bytes are always exact, which keeps leak tracking exact too.
+ *
+ * With `enabled` false, the default when JC_DISABLE_MEMORY_STATS is defined, the resource only forwards.
+ *
+ * Wrap an arena (`base_allocator`) or any other memory_resource. Typed allocators such as `cached_pool_allocator`
+ * can't be wrapped, not even through `abstract_allocator`: they hand out runs of one `T` rather than any size and
+ * alignment asked for, so they aren't memory resources. Pass the stats resource to such a pool as its upstream instead
+ * to see what the pool draws.
+ */
+template <bool enabled = JC_MEMORY_STATS_ENABLED>
+class basic_stats_resource final : public std::pmr::memory_resource
+{
+private:
+    struct thread_counters
+    {
+        std::array<std::atomic<u64>, memory_stats::size_classes> allocations_{};
+        std::array<std::atomic<u64>, memory_stats::size_classes> deallocations_{};
+        std::array<std::atomic<u64>, memory_stats::latency_buckets> latency_{};
+        std::atomic<u64> allocated_bytes_   = 0;
+        std::atomic<u64> deallocated_bytes_ = 0;
+        std::atomic<u64> failures_          = 0;
+        std::atomic<i64> high_water_        = 0;
+        // only touched by the owning thread
+        i64 net_bytes_         = 0;
+        u32 until_sample_      = 0;
+        std::thread::id owner_ = std::this_thread::get_id();
+        thread_counters *next_ = nullptr;
+    };
+
+public:
+    /**
+     * @param upstream resource every request is forwarded to, it must outlive this object.
+     * @param sample_every time one in this many allocations, 1 times all of them.
+     */
+    explicit basic_stats_resource(std::pmr::memory_resource &upstream, const u32 sample_every = 1) noexcept
+        : upstream_(&upstream), sample_every_(std::max<u32>(sample_every, 1))
+    {
+    }
+
+    ~basic_stats_resource() noexcept override
+    {
+        thread_counters *node = counters_.load(std::memory_order::acquire);
+        while (node != nullptr)
+        {
+            delete std::exchange(node, node->next_);
+        }
+    }
+
+    basic_stats_resource(const basic_stats_resource &)            = delete;
+    basic_stats_resource &operator=(const basic_stats_resource &) = delete;
+    basic_stats_resource(basic_stats_resource &&)                 = delete;
+    basic_stats_resource &operator=(basic_stats_resource &&)      = delete;
+
+    [[nodiscard]] std::pmr::memory_resource *upstream() const noexcept
+    {
+        return upstream_;
+    }
+
+    /**
+     * @brief Sums every thread's counters. Safe to call from any thread while the resource is in use, the result is
+     * then a close but not atomic picture.
+     */
+    [[nodiscard]] memory_stats snapshot() noexcept
+    {
+        memory_stats stats;
+        if constexpr (enabled)
+        {
+            for (thread_counters *node = counters_.load(std::memory_order::acquire); node != nullptr;
+                 node                  = node->next_)
+            {
+                for (std::size_t i = 0; i < memory_stats::size_classes; i++)
+                {
+                    stats.allocations_[i] += node->allocations_[i].load(std::memory_order::relaxed);
+                    stats.deallocations_[i] += node->deallocations_[i].load(std::memory_order::relaxed);
+                }
+                for (std::size_t i = 0; i < memory_stats::latency_buckets; i++)
+                {
+                    stats.latency_[i] += node->latency_[i].load(std::memory_order::relaxed);
+                }
+                stats.allocated_bytes_ += node->allocated_bytes_.load(std::memory_order::relaxed);
+                stats.deallocated_bytes_ += node->deallocated_bytes_.load(std::memory_order::relaxed);
+                stats.failures_ += node->failures_.load(std::memory_order::relaxed);
+                stats.thread_high_water_ =
+                    std::max(stats.thread_high_water_, node->high_water_.load(std::memory_order::relaxed));
+            }
+
+            i64 high_water = high_water_.load(std::memory_order::relaxed);
+            while (stats.live_bytes() > high_water &&
+                   !high_water_.compare_exchange_weak(high_water, stats.live_bytes(), std::memory_order::relaxed))
+            {
+            }
+            stats.high_water_ = std::max(high_water, stats.live_bytes());
+        }
+        return stats;
+    }
+
+    [[nodiscard]] static constexpr std::size_t size_class(const std::size_t bytes) noexcept
+    {
+        // 16 bytes and below share class 0, then one class per power of two
+        const std::size_t width = static_cast<std::size_t>(std::bit_width(bytes > 16 ? bytes - 1 : std::size_t{15}));
+        return std::min(width - 4, memory_stats::size_classes - 1);
+    }
+
+private:
+    void *do_allocate(const std::size_t bytes, const std::size_t alignment) override
+    {
+        if constexpr (!enabled)
+        {
+            return upstream_->allocate(bytes, alignment);
+        }
+        else
+        {
+            thread_counters &counters = local_counters();
+            if (counters.until_sample_ != 0)
+            {
+                --counters.until_sample_;
+                return record_allocation(counters, bytes, allocate_or_count(counters, bytes, alignment));
+            }
+
+            counters.until_sample_ = sample_every_ - 1;
+            const auto start       = std::chrono::steady_clock::now();
+            void *result           = allocate_or_count(counters, bytes, alignment);
+            const auto elapsed     = std::chrono::nanoseconds(std::chrono::steady_clock::now() - start).count();
+            const std::size_t bucket =
+                std::min<std::size_t>(std::bit_width(static_cast<u64>(std::max<i64>(elapsed, 1))) - 1,
+                                      memory_stats::latency_buckets - 1);
+            bump(counters.latency_[bucket], 1);
+            return record_allocation(counters, bytes, result);
+        }
+    }
+
+    void do_deallocate(void *p, const std::size_t bytes, const std::size_t alignment) override
+    {
+        upstream_->deallocate(p, bytes, alignment);
+        if constexpr (enabled)
+        {
+            if (p == nullptr)
+            {
+                return;
+            }
+            thread_counters &counters = local_counters();
+            bump(counters.deallocations_[size_class(bytes)], 1);
+            bump(counters.deallocated_bytes_, bytes);
+            counters.net_bytes_ -= static_cast<i64>(bytes);
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    void *allocate_or_count(thread_counters &counters, const std::size_t bytes, const std::size_t alignment)
+    {
+        try
+        {
+            return upstream_->allocate(bytes, alignment);
+        }
+        catch (...)
+        {
+            bump(counters.failures_, 1);
+            throw;
+        }
+    }
+
+    void *record_allocation(thread_counters &counters, const std::size_t bytes, void *result) noexcept
+    {
+        // arenas like base_allocator report exhaustion with nullptr instead of throwing
+        if (result == nullptr)
+        {
+            bump(counters.failures_, 1);
+            return result;
+        }
+        bump(counters.allocations_[size_class(bytes)], 1);
+        bump(counters.allocated_bytes_, bytes);
+        counters.net_bytes_ += static_cast<i64>(bytes);
+        if (counters.net_bytes_ > counters.high_water_.load(std::memory_order::relaxed))
+        {
+            counters.high_water_.store(counters.net_bytes_, std::memory_order::relaxed);
+        }
+        return result;
+    }
+
+    /*
+     * single writer, so a load and a store is enough and avoids a locked instruction on the hot path.
+     */
+    static void bump(std::atomic<u64> &counter, const u64 amount) noexcept
+    {
+        counter.store(counter.load(std::memory_order::relaxed) + amount, std::memory_order::relaxed);
+    }
+
+    thread_counters &local_counters()
+    {
+        // resources are told apart by id rather than address so a new resource never sees a dead one's block
+        thread_local u64 owner              = 0;
+        thread_local thread_counters *local = nullptr;
+        if (owner != id_)
+        {
+            local = find_or_register();
+            owner = id_;
+        }
+        return *local;
+    }
+
+    /*
+     * slow path when a thread switches between resources, finds its block again or adds one.
+     */
+    thread_counters *find_or_register()
+    {
+        const std::thread::id self = std::this_thread::get_id();
+        thread_counters *head      = counters_.load(std::memory_order::acquire);
+        for (thread_counters *node = head; node != nullptr; node = node->next_)
+        {
+            if (node->owner_ == self)
+            {
+                return node;
+            }
+        }
+
+        auto *node = new thread_counters;
+        do
+        {
+            node->next_ = head;
+        } while (!counters_.compare_exchange_weak(head, node, std::memory_order::release, std::memory_order::relaxed));
+        return node;
+    }
+
+    inline static std::atomic<u64> next_id_ = 1;
+
+    std::pmr::memory_resource *upstream_;
+    u32 sample_every_;
+    const u64 id_ = next_id_.fetch_add(1, std::memory_order::relaxed);
+    std::atomic<thread_counters *> counters_ = nullptr;
+    std::atomic<i64> high_water_             = 0;
+};
+
+using stats_resource = basic_stats_resource<>;
+
+} // namespace jc::memory
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef JC_STREAM_COPY_H
+#define JC_STREAM_COPY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace jc::memory
+{
+
+namespace detail
+{
+#if defined(__x86_64__)
+/*
+ * the streaming loops, dst is 64 byte aligned and bytes a multiple of 64. Each one is compiled for its own
+ * instruction set so the rest of the build doesn't need -mavx2/-mavx512f, and picked once at runtime.
+ */
+__attribute__((target("avx512f"))) inline void stream_lines_avx512(std::byte *dst, const std::byte *src,
+                                                                   const std::size_t bytes) noexcept
+{
+    for (std::size_t i = 0; i < bytes; i += 64)
+    {
+        _mm512_stream_si512(reinterpret_cast<__m512i *>(dst + i), _mm512_loadu_si512(src + i));
+    }
+}
+
+__attribute__((target("avx2"))) inline void stream_lines_avx2(std::byte *dst, const std::byte *src,
+                                                              const std::size_t bytes) noexcept
+{
+    for (std::size_t i = 0; i < bytes; i += 32)
+    {
+        _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i)));
+    }
+}
+
+inline void stream_lines_sse2(std::byte *dst, const std::byte *src, const std::size_t bytes) noexcept
+{
+    for (std::size_t i = 0; i < bytes; i += 16)
+    {
+        _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+    }
+}
+
+using stream_lines_fn = void (*)(std::byte *, const std::byte *, std::size_t) noexcept;
+
+inline stream_lines_fn select_stream_lines() noexcept
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return stream_lines_avx512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return stream_lines_avx2;
+    }
+    return stream_lines_sse2;
+}
+#endif
+} // namespace detail
+
+/**
+ * @brief Which streaming loop stream_copy runs on this CPU: "avx512", "avx2", "sse2", or "memcpy" off x86-64.
+ */
+inline const char *stream_copy_isa() noexcept
+{
+#if defined(__x86_64__)
+    const detail::stream_lines_fn lines = detail::select_stream_lines();
+    return lines == detail::stream_lines_avx512 ? "avx512" : lines == detail::stream_lines_avx2 ? "avx2" : "sse2";
+#else
+    return "memcpy";
+#endif
+}
+
+/**
+ * @brief Copies `bytes` bytes to `dst` with non-temporal stores, so the destination lines go to memory without
+ * being pulled into the writer's cache. The unaligned head and tail are copied normally.
+ *
+ * Streaming stores are weakly ordered, call stream_fence() before publishing the data to another thread.
+ */
+inline void stream_copy(void *dst, const void *src, const std::size_t bytes) noexcept
+{
+#if defined(__x86_64__)
+    static const detail::stream_lines_fn stream_lines = detail::select_stream_lines();
+
+    auto *out      = static_cast<std::byte *>(dst);
+    const auto *in = static_cast<const std::byte *>(src);
+
+    const std::size_t head = std::min(bytes, (64 - reinterpret_cast<std::uintptr_t>(out) % 64) % 64);
+    const std::size_t body = (bytes - head) & ~std::size_t{63};
+    std::memcpy(out, in, head);
+    stream_lines(out + head, in + head, body);
+    std::memcpy(out + head + body, in + head + body, bytes - head - body);
+#else
+    std::memcpy(dst, src, bytes);
+#endif
+}
+
+/**
+ * @brief Orders every earlier streaming store before the stores that follow it, e.g. a release of the index.
+ */
+inline void stream_fence() noexcept
+{
+#if defined(__x86_64__)
+    _mm_sfence();
+#else
+    std::atomic_thread_fence(std::memory_order::release);
+#endif
+}
+
+} // namespace jc::memory
+
+#endif
@@ -1,5 +1,6 @@
 #ifndef UTIL_H
 #define UTIL_H
+#include <cstddef>
 #include <cstdint>
 
 using u8  = uint8_t;
@@ -14,11 +15,9 @@ using i64 = int64_t;
 
 constexpr u8 u8_max = static_cast<u8>(-1);
 
+// divisor must be positive and amount + divisor must not overflow
 [[nodiscard]] constexpr size_t int_ceil(const size_t amount, const size_t divisor) noexcept
 {
-    static_assert(divisor > 0, "int_ceil divisor must be positive");
-    static_assert(amount + divisor < static_cast<size_t>(-1), "int_ceil overflow: amount + divisor is too large");
-
     return (amount + divisor - 1) / divisor;
 }
 #endif // UTIL_H
@@ -0,0 +1,154 @@
+#ifndef JC_TEST_LINEARIZABILITY_H
+#define JC_TEST_LINEARIZABILITY_H
+
+#include <jc_collections/util.h>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace jc::test
+{
+
+enum class op_kind : u8
+{
+    put,
+    read,
+};
+
+/*
+ * one completed call: what it was, the value put or read, whether it succeeded, and the global ticks it was invoked
+ * and returned at.
+ */
+struct operation
+{
+    op_kind kind_;
+    u64 value_;
+    bool ok_;
+    u64 invoked_;
+    u64 returned_;
+};
+
+/*
+ * what a producer and a consumer did, each in its own program order.
+ */
+struct history
+{
+    std::vector<operation> producer_;
+    std::vector<operation> consumer_;
+};
+
+/*
+ * ticks from one shared counter, so invocation and response order across threads is real time order.
+ */
+class history_clock
+{
+private:
+    std::atomic<u64> ticks_ = 0;
+
+public:
+    u64 tick() noexcept
+    {
+        return ticks_.fetch_add(1, std::memory_order::seq_cst);
+    }
+};
+
+/*
+ * Wing & Gong search for a linearization of `recorded` against a FIFO queue holding at most `capacity` elements, where
+ * a put fails only when the queue is full and a read fails only when it is empty.
+ *
+ * With one producer and one consumer, every thread's calls are sequential, so only the next call of each thread is
+ * ever a candidate, and the queue's contents follow from how many calls of each thread are linearized. The search
+ * therefore memoizes on that pair and is quadratic instead of exponential.
+ */
+class spsc_linearizability
+{
+private:
+    const history &recorded_;
+    const std::size_t capacity_;
+    std::vector<u64> accepted_;
+    std::vector<std::size_t> accepted_before_;
+    std::vector<std::size_t> taken_before_;
+    std::vector<bool> visited_;
+
+    [[nodiscard]] bool valid_put(const operation &put, const std::size_t size) const noexcept
+    {
+        return put.ok_ ? size < capacity_ : size == capacity_;
+    }
+
+    [[nodiscard]] bool valid_read(const operation &read, const std::size_t taken, const std::size_t size) const noexcept
+    {
+        return read.ok_ ? size > 0 && accepted_[taken] == read.value_ : size == 0;
+    }
+
+    bool search(const std::size_t puts, const std::size_t reads)
+    {
+        const std::size_t producer_ops = recorded_.producer_.size();
+        const std::size_t consumer_ops = recorded_.consumer_.size();
+        if (puts == producer_ops && reads == consumer_ops)
+        {
+            return true;
+        }
+        const std::size_t state = puts * (consumer_ops + 1) + reads;
+        if (visited_[state])
+        {
+            return false;
+        }
+        visited_[state] = true;
+
+        // a read can't take an element that hasn't been put yet in this order
+        const std::size_t taken = taken_before_[reads];
+        if (taken > accepted_before_[puts])
+        {
+            return false;
+        }
+        const std::size_t size = accepted_before_[puts] - taken;
+
+        const operation *put  = puts < producer_ops ? &recorded_.producer_[puts] : nullptr;
+        const operation *read = reads < consumer_ops ? &recorded_.consumer_[reads] : nullptr;
+
+        // a call can go first unless the other thread's next call had already returned before it was invoked
+        if (put != nullptr && (read == nullptr || read->returned_ > put->invoked_) && valid_put(*put, size) &&
+            search(puts + 1, reads))
+        {
+            return true;
+        }
+        return read != nullptr && (put == nullptr || put->returned_ > read->invoked_) &&
+               valid_read(*read, taken, size) && search(puts, reads + 1);
+    }
+
+public:
+    spsc_linearizability(const history &recorded, const std::size_t capacity)
+        : recorded_(recorded), capacity_(capacity)
+    {
+        accepted_before_.push_back(0);
+        for (const operation &put : recorded_.producer_)
+        {
+            if (put.ok_)
+            {
+                accepted_.push_back(put.value_);
+            }
+            accepted_before_.push_back(accepted_.size());
+        }
+        taken_before_.push_back(0);
+        for (const operation &read : recorded_.consumer_)
+        {
+            taken_before_.push_back(taken_before_.back() + (read.ok_ ? 1 : 0));
+        }
+        visited_.assign((recorded_.producer_.size() + 1) * (recorded_.consumer_.size() + 1), false);
+    }
+
+    [[nodiscard]] bool check()
+    {
+        return search(0, 0);
+    }
+};
+
+inline bool linearizable(const history &recorded, const std::size_t capacity)
+{
+    return spsc_linearizability(recorded, capacity).check();
+}
+
+} // namespace jc::test
+
+#endif
@@ -0,0 +1,453 @@
+#ifndef JC_TEST_MODEL_CHECKER_H
+#define JC_TEST_MODEL_CHECKER_H
+
+#include <jc_collections/util.h>
+
+#include <ucontext.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * A small relacy/CDSChecker style checker. Threads run as fibers on one OS thread and every atomic operation is a
+ * scheduling point, so a test is run once per interleaving of its atomic operations, depth first, optionally bounded
+ * by the number of preemptions (CHESS).
+ *
+ * Interleavings are sequentially consistent. Weaker orderings are caught the way relacy catches most of them: each
+ * thread carries a vector clock, release stores and acquire loads carry clocks between threads, and every access to a
+ * model::var is checked against the last conflicting ones. A plain access that isn't ordered after a conflicting one by
+ * happens-before is a data race, which is exactly what a missing release or acquire on a queue index turns into.
+ */
+namespace jc::test::model
+{
+
+constexpr std::size_t max_threads = 4;
+constexpr std::size_t no_thread   = max_threads;
+
+using vector_clock = std::array<u64, max_threads>;
+
+struct options
+{
+    std::size_t max_preemptions = std::numeric_limits<std::size_t>::max();
+    std::size_t max_executions  = 1'000'000;
+    std::size_t stack_bytes     = 256 * 1024;
+};
+
+struct result
+{
+    std::size_t executions = 0;
+    bool exhausted         = false;
+    std::string failure;
+    /* thread picked at each scheduling point of the failing execution */
+    std::vector<std::size_t> schedule;
+
+    [[nodiscard]] bool ok() const noexcept
+    {
+        return failure.empty();
+    }
+};
+
+class scheduler;
+
+namespace detail
+{
+inline scheduler *active = nullptr;
+} // namespace detail
+
+class scheduler
+{
+private:
+    struct decision
+    {
+        std::size_t taken_ = 0;
+        std::vector<std::size_t> choices_;
+    };
+
+    struct fiber
+    {
+        ucontext_t context_{};
+        std::unique_ptr<char[]> stack_;
+        std::function<void()> body_;
+        vector_clock clock_{};
+        bool finished_ = false;
+    };
+
+    options options_;
+    ucontext_t main_{};
+    std::vector<fiber> fibers_;
+    std::vector<decision> decisions_;
+    std::size_t depth_       = 0;
+    std::size_t current_     = no_thread;
+    std::size_t preemptions_ = 0;
+    std::string failure_;
+
+    static void trampoline()
+    {
+        scheduler &self = *detail::active;
+        self.fibers_[self.current_].body_();
+        self.fibers_[self.current_].finished_ = true;
+        self.switch_to(self.pick(), true);
+    }
+
+    /*
+     * the next thread to run: replays the recorded decision at this depth or opens a new one. The running thread is
+     * always the first choice, so a schedule that keeps its first choices has no preemptions.
+     */
+    std::size_t pick()
+    {
+        std::vector<std::size_t> runnable;
+        const bool current_runnable = current_ != no_thread && !fibers_[current_].finished_;
+        if (current_runnable)
+        {
+            runnable.push_back(current_);
+        }
+        if (!current_runnable || preemptions_ < options_.max_preemptions)
+        {
+            for (std::size_t i = 0; i < fibers_.size(); i++)
+            {
+                if (i != current_ && !fibers_[i].finished_)
+                {
+                    runnable.push_back(i);
+                }
+            }
+        }
+        if (runnable.empty())
+        {
+            return no_thread;
+        }
+        if (depth_ == decisions_.size())
+        {
+            decisions_.push_back(decision{0, runnable});
+        }
+        const decision &at     = decisions_[depth_++];
+        const std::size_t next = at.choices_[at.taken_];
+        if (current_runnable && next != current_)
+        {
+            ++preemptions_;
+        }
+        return next;
+    }
+
+    void switch_to(const std::size_t next, const bool from_finished)
+    {
+        const std::size_t previous = current_;
+        current_                   = next;
+        ucontext_t *from           = previous == no_thread || from_finished ? nullptr : &fibers_[previous].context_;
+        ucontext_t *to             = next == no_thread ? &main_ : &fibers_[next].context_;
+        if (from == nullptr)
+        {
+            setcontext(to);
+        }
+        else if (from != to)
+        {
+            swapcontext(from, to);
+        }
+    }
+
+    /* moves to the next unexplored schedule, false once every one has been run */
+    bool advance()
+    {
+        while (!decisions_.empty())
+        {
+            decision &last = decisions_.back();
+            if (++last.taken_ < last.choices_.size())
+            {
+                return true;
+            }
+            decisions_.pop_back();
+        }
+        return false;
+    }
+
+    void run_once(const std::vector<std::function<void()>> &threads)
+    {
+        // stacks are kept across executions, allocating them each time dominates small models
+        fibers_.resize(threads.size());
+        for (std::size_t i = 0; i < threads.size(); i++)
+        {
+            fiber &f = fibers_[i];
+            if (f.stack_ == nullptr)
+            {
+                f.stack_ = std::make_unique_for_overwrite<char[]>(options_.stack_bytes);
+            }
+            f.body_     = threads[i];
+            f.finished_ = false;
+            f.clock_.fill(0);
+            f.clock_[i] = 1;
+            getcontext(&f.context_);
+            f.context_.uc_stack.ss_sp   = f.stack_.get();
+            f.context_.uc_stack.ss_size = options_.stack_bytes;
+            f.context_.uc_link          = nullptr;
+            makecontext(&f.context_, trampoline, 0);
+        }
+        depth_       = 0;
+        current_     = no_thread;
+        preemptions_ = 0;
+
+        const std::size_t first = pick();
+        current_                = first;
+        swapcontext(&main_, &fibers_[first].context_);
+        current_ = no_thread;
+    }
+
+public:
+    explicit scheduler(const options opts = {}) : options_(opts)
+    {
+    }
+
+    scheduler(const scheduler &)            = delete;
+    scheduler &operator=(const scheduler &) = delete;
+    scheduler(scheduler &&)                 = delete;
+    scheduler &operator=(scheduler &&)      = delete;
+
+    ~scheduler() = default;
+
+    /**
+     * @brief Runs `setup`, the threads and `check` once per schedule until every schedule has been explored, one
+     * fails, or max_executions is reached. Setup and check run outside the model, their accesses count as
+     * initialisation and aren't scheduling points.
+     */
+    result explore(const std::function<void()> &setup, const std::vector<std::function<void()>> &threads,
+                   const std::function<void()> &check)
+    {
+        result outcome;
+        decisions_.clear();
+        detail::active = this;
+        do
+        {
+            failure_.clear();
+            setup();
+            run_once(threads);
+            check();
+            ++outcome.executions;
+            if (!failure_.empty())
+            {
+                outcome.failure = failure_;
+                for (std::size_t i = 0; i < decisions_.size(); i++)
+                {
+                    outcome.schedule.push_back(decisions_[i].choices_[decisions_[i].taken_]);
+                }
+                break;
+            }
+        } while (outcome.executions < options_.max_executions && advance());
+        outcome.exhausted = outcome.ok() && decisions_.empty();
+        detail::active    = nullptr;
+        return outcome;
+    }
+
+    /* whether the caller is one of the model's threads, accesses outside them are initialisation */
+    [[nodiscard]] bool in_thread() const noexcept
+    {
+        return current_ != no_thread;
+    }
+
+    [[nodiscard]] std::size_t thread() const noexcept
+    {
+        return current_;
+    }
+
+    vector_clock &clock() noexcept
+    {
+        return fibers_[current_].clock_;
+    }
+
+    void yield()
+    {
+        switch_to(pick(), false);
+    }
+
+    void fail(std::string message)
+    {
+        if (failure_.empty())
+        {
+            failure_ = std::move(message);
+        }
+    }
+};
+
+inline scheduler *running() noexcept
+{
+    return detail::active != nullptr && detail::active->in_thread() ? detail::active : nullptr;
+}
+
+/**
+ * @brief Records a failed expectation, for checks made inside the model's threads and its check function.
+ */
+inline void expect(const bool condition, const char *message)
+{
+    if (!condition && detail::active != nullptr)
+    {
+        detail::active->fail(message);
+    }
+}
+
+/**
+ * @brief Drop-in for std::atomic with load/store: every operation is a scheduling point, release stores publish the
+ * storing thread's clock and acquire loads join it. Relaxed stores publish nothing.
+ */
+template <typename T>
+class atomic
+{
+private:
+    T value_;
+    vector_clock released_{};
+    bool has_release_ = false;
+
+    static bool acquires(const std::memory_order order) noexcept
+    {
+        return order == std::memory_order::acquire || order == std::memory_order::acq_rel ||
+               order == std::memory_order::seq_cst || order == std::memory_order::consume;
+    }
+
+    static bool releases(const std::memory_order order) noexcept
+    {
+        return order == std::memory_order::release || order == std::memory_order::acq_rel ||
+               order == std::memory_order::seq_cst;
+    }
+
+public:
+    atomic(const T value = T{}) noexcept : value_(value)
+    {
+    }
+
+    atomic(const atomic &)            = delete;
+    atomic &operator=(const atomic &) = delete;
+
+    T load(const std::memory_order order = std::memory_order::seq_cst) noexcept
+    {
+        scheduler *model = running();
+        if (model == nullptr)
+        {
+            return value_;
+        }
+        model->yield();
+        if (acquires(order) && has_release_)
+        {
+            vector_clock &clock = model->clock();
+            for (std::size_t i = 0; i < max_threads; i++)
+            {
+                clock[i] = std::max(clock[i], released_[i]);
+            }
+        }
+        return value_;
+    }
+
+    T load(const std::memory_order order = std::memory_order::seq_cst) const noexcept
+    {
+        return const_cast<atomic *>(this)->load(order);
+    }
+
+    void store(const T value, const std::memory_order order = std::memory_order::seq_cst) noexcept
+    {
+        scheduler *model = running();
+        if (model == nullptr)
+        {
+            value_       = value;
+            has_release_ = false;
+            return;
+        }
+        model->yield();
+        value_       = value;
+        has_release_ = releases(order);
+        if (has_release_)
+        {
+            vector_clock &clock = model->clock();
+            released_           = clock;
+            ++clock[model->thread()];
+        }
+    }
+};
+
+/**
+ * @brief A plain, non-atomic value whose reads and writes are checked for data races against happens-before.
+ */
+template <typename T>
+class var
+{
+private:
+    T value_{};
+    std::size_t writer_ = no_thread;
+    u64 written_at_     = 0;
+    vector_clock read_at_{};
+
+    void on_read() const
+    {
+        scheduler *model = running();
+        if (model == nullptr)
+        {
+            return;
+        }
+        const std::size_t self = model->thread();
+        if (writer_ != no_thread && writer_ != self && model->clock()[writer_] < written_at_)
+        {
+            model->fail("data race: read of a var not ordered after its last write");
+        }
+        const_cast<var *>(this)->read_at_[self] = model->clock()[self];
+    }
+
+    void on_write()
+    {
+        scheduler *model = running();
+        if (model == nullptr)
+        {
+            writer_ = no_thread;
+            read_at_.fill(0);
+            return;
+        }
+        const std::size_t self = model->thread();
+        const vector_clock &at = model->clock();
+        if (writer_ != no_thread && writer_ != self && at[writer_] < written_at_)
+        {
+            model->fail("data race: write of a var not ordered after its last write");
+        }
+        for (std::size_t i = 0; i < max_threads; i++)
+        {
+            if (i != self && read_at_[i] != 0 && at[i] < read_at_[i])
+            {
+                model->fail("data race: write of a var not ordered after a read of it");
+            }
+        }
+        writer_     = self;
+        written_at_ = at[self];
+        read_at_.fill(0);
+    }
+
+public:
+    var() = default;
+
+    explicit var(const T value) : value_(value)
+    {
+        on_write();
+    }
+
+    var(const var &other) : value_(other.get())
+    {
+        on_write();
+    }
+
+    var &operator=(const var &other)
+    {
+        const T value = other.get();
+        on_write();
+        value_ = value;
+        return *this;
+    }
+
+    [[nodiscard]] T get() const
+    {
+        on_read();
+        return value_;
+    }
+};
+
+} // namespace jc::test::model
+
+#endif
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <jc_collections/collections/flat_map.hpp>
+#include <jc_collections/memory/base_allocator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/*
+ * Every layout is checked against std::lower_bound, at sizes around the B-tree node boundaries and with probes
+ * between, below and above the keys.
+ */
+namespace
+{
+
+using jc::collections::flat_map;
+using jc::collections::flat_set;
+namespace flat_layout = jc::collections::flat_layout;
+
+template <typename K>
+std::vector<K> spaced_keys(const std::size_t n)
+{
+    // every third value, starting below zero for signed keys, so each key has a missing neighbour on both sides
+    std::vector<K> keys(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        keys[i] = static_cast<K>(static_cast<K>(3 * i) - static_cast<K>(std::is_signed_v<K> ? 3 * (n / 2) : 0));
+    }
+    return keys;
+}
+
+template <typename Set>
+class flat_set_layouts : public testing::Test
+{
+};
+
+template <typename K, typename Layout>
+struct set_of
+{
+    using key    = K;
+    using layout = Layout;
+};
+
+using set_types = testing::Types<set_of<u32, flat_layout::sorted>, set_of<u32, flat_layout::eytzinger>,
+                                 set_of<u32, flat_layout::btree>, set_of<i64, flat_layout::eytzinger>,
+                                 set_of<i64, flat_layout::btree>, set_of<u64, flat_layout::btree>,
+                                 set_of<i32, flat_layout::btree>, set_of<double, flat_layout::btree>>;
+TYPED_TEST_SUITE(flat_set_layouts, set_types);
+
+TYPED_TEST(flat_set_layouts, lower_bound_matches_std)
+{
+    using K = typename TypeParam::key;
+    jc::memory::base_allocator arena(1 << 22);
+    for (const std::size_t n : {0, 1, 2, 15, 16, 17, 136, 1000, 4097})
+    {
+        const std::vector<K> keys = spaced_keys<K>(n);
+        flat_set<K, typename TypeParam::layout> set(arena);
+        ASSERT_TRUE(set.assign_sorted(keys));
+        for (std::size_t i = 0; i < n; i++)
+        {
+            for (const K probe : {static_cast<K>(keys[i] - 1), keys[i], static_cast<K>(keys[i] + 1)})
+            {
+                const auto expected = std::lower_bound(keys.begin(), keys.end(), probe) - keys.begin();
+                ASSERT_EQ(set.lower_bound(probe), static_cast<std::size_t>(expected)) << n << " " << probe;
+            }
+        }
+        if (n != 0)
+        {
+            EXPECT_EQ(set.lower_bound(static_cast<K>(keys.back() + 1)), n);
+            EXPECT_EQ(set.lower_bound(std::is_signed_v<K> ? static_cast<K>(keys.front() - 1) : K{0}), 0);
+        }
+        EXPECT_EQ(set.lower_bound(K{1}), static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), K{1}) -
+                                                                   keys.begin()));
+    }
+}
+
+TYPED_TEST(flat_set_layouts, insert_and_erase_keep_the_index_current)
+{
+    using K = typename TypeParam::key;
+    jc::memory::base_allocator arena(1 << 22);
+    flat_set<K, typename TypeParam::layout> set(arena);
+    for (const K key : spaced_keys<K>(300))
+    {
+        ASSERT_TRUE(set.insert(key));
+    }
+    EXPECT_FALSE(set.insert(K{3}));
+    EXPECT_TRUE(std::is_sorted(set.keys().begin(), set.keys().end()));
+    for (const K key : spaced_keys<K>(300))
+    {
+        ASSERT_TRUE(set.contains(key));
+        ASSERT_FALSE(set.contains(static_cast<K>(key + 1)));
+    }
+    EXPECT_TRUE(set.erase(K{3}));
+    EXPECT_FALSE(set.erase(K{3}));
+    EXPECT_FALSE(set.contains(K{3}));
+    EXPECT_EQ(set.size(), 299);
+}
+
+TEST(flat_map, find_returns_the_value_of_each_key)
+{
+    jc::memory::base_allocator arena(1 << 20);
+    const std::vector<u64> keys = spaced_keys<u64>(1000);
+    std::vector<u32> values(keys.size());
+    for (std::size_t i = 0; i < values.size(); i++)
+    {
+        values[i] = static_cast<u32>(i * 7);
+    }
+    flat_map<u64, u32, flat_layout::btree> map(arena);
+    ASSERT_TRUE(map.assign_sorted(keys, values));
+    for (std::size_t i = 0; i < keys.size(); i++)
+    {
+        ASSERT_NE(map.find(keys[i]), nullptr);
+        EXPECT_EQ(*map.find(keys[i]), values[i]);
+        EXPECT_EQ(map.find(keys[i] + 1), nullptr);
+    }
+
+    ASSERT_TRUE(map.insert(1, 42));
+    EXPECT_EQ(*map.find(1), 42);
+    EXPECT_EQ(*map.find(3), 7);
+    EXPECT_TRUE(map.erase(0));
+    EXPECT_EQ(map.find(0), nullptr);
+    EXPECT_EQ(*map.find(1), 42);
+    EXPECT_EQ(map.values().front(), 42);
+}
+
+TEST(flat_map, assign_sorted_rejects_unsorted_keys)
+{
+    jc::memory::base_allocator arena(1 << 20);
+    flat_map<int, int, flat_layout::eytzinger> map(arena);
+    const std::vector<int> keys{1, 3, 2};
+    const std::vector<int> values{1, 2, 3};
+    EXPECT_FALSE(map.assign_sorted(keys, values));
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), nullptr);
+}
+
+} // namespace
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <jc_collections/collections/lookup_table.hpp>
+#include <jc_collections/memory/base_allocator.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/*
+ * The static tables are checked where they are built, at compile time, and the arena tables against them.
+ */
+namespace
+{
+
+using jc::collections::arena_lookup_table;
+using jc::collections::make_static_lookup_table;
+
+constexpr std::size_t entry_count = 500;
+
+constexpr std::array<std::pair<u64, u32>, entry_count> shuffled_entries() noexcept
+{
+    std::array<std::pair<u64, u32>, entry_count> entries{};
+    u64 state = 0x9E3779B97F4A7C15;
+    for (std::size_t i = 0; i < entry_count; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        entries[i] = {state, static_cast<u32>(i)};
+    }
+    return entries;
+}
+
+constexpr auto shuffled = make_static_lookup_table(shuffled_entries());
+static_assert(shuffled.successful_init() && shuffled.size() == entry_count);
+static_assert(std::is_sorted(shuffled.keys().begin(), shuffled.keys().end()));
+static_assert(*shuffled.find(shuffled_entries()[123].first) == 123);
+static_assert(shuffled.find(1) == nullptr);
+
+constexpr std::array<std::pair<i64, i64>, 3> ladder_entries{{{0, 1}, {100, 5}, {1000, 25}}};
+constexpr auto ladder = make_static_lookup_table(ladder_entries);
+static_assert(*ladder.floor(0) == 1 && *ladder.floor(99) == 1 && *ladder.floor(100) == 5);
+static_assert(*ladder.floor(1'000'000) == 25 && ladder.floor(-1) == nullptr);
+
+constexpr std::array<std::pair<int, int>, 3> duplicate_entries{{{1, 1}, {2, 2}, {1, 3}}};
+static_assert(!make_static_lookup_table(duplicate_entries).successful_init());
+static_assert(make_static_lookup_table(duplicate_entries).empty());
+
+constexpr bool fixed_vector_stops_at_capacity()
+{
+    jc::collections::fixed_vector<int, 2> values;
+    return values.push_back(1) && values.push_back(2) && !values.push_back(3) && values.size() == 2 && values[1] == 2;
+}
+static_assert(fixed_vector_stops_at_capacity());
+
+TEST(lookup_table, arena_table_matches_static_table)
+{
+    jc::memory::base_allocator arena(1 << 20);
+    const auto entries = shuffled_entries();
+    const arena_lookup_table<u64, u32> table(entries, arena);
+    ASSERT_TRUE(table.successful_init());
+    ASSERT_EQ(table.size(), shuffled.size());
+    EXPECT_TRUE(std::equal(table.keys().begin(), table.keys().end(), shuffled.keys().begin()));
+    EXPECT_TRUE(std::equal(table.values().begin(), table.values().end(), shuffled.values().begin()));
+    for (const auto &[key, value] : entries)
+    {
+        ASSERT_NE(table.find(key), nullptr);
+        EXPECT_EQ(*table.find(key), value);
+    }
+    EXPECT_FALSE(table.contains(1));
+}
+
+TEST(lookup_table, arena_table_reports_exhausted_arena)
+{
+    jc::memory::base_allocator arena(4096);
+    const auto entries = shuffled_entries();
+    const arena_lookup_table<u64, u32> table(entries, arena);
+    EXPECT_FALSE(table.successful_init());
+    EXPECT_TRUE(table.empty());
+}
+
+TEST(lookup_table, arena_vector_grows_and_moves)
+{
+    jc::memory::base_allocator arena(1 << 20);
+    jc::collections::arena_vector<int> values(arena);
+    for (int i = 0; i < 1000; i++)
+    {
+        ASSERT_TRUE(values.push_back(i));
+    }
+    jc::collections::arena_vector<int> moved(std::move(values));
+    EXPECT_EQ(moved.size(), 1000);
+    EXPECT_EQ(moved[999], 999);
+    EXPECT_TRUE(values.empty());
+}
+
+} // namespace
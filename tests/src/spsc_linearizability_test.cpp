@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <jc_collections/lockfree/spsc.hpp>
+#include "../include/linearizability.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <thread>
+
+/*
+ * Short concurrent histories of try_put/try_read on real threads, each call stamped with invocation and response
+ * ticks, checked for a linearization against a bounded FIFO. Unlike the stress tests this also holds the failed calls
+ * to account: a try_put may only fail if the queue could have been full at some point during the call, and a try_read
+ * only if it could have been empty.
+ */
+namespace
+{
+
+using jc::test::history;
+using jc::test::history_clock;
+using jc::test::op_kind;
+using jc::test::operation;
+
+constexpr std::size_t capacity       = 4;
+constexpr std::size_t rounds         = 500;
+constexpr std::size_t calls_per_side = 24;
+
+template <typename Queue>
+history record_round(Queue &queue, history_clock &clock, const u64 first_value)
+{
+    history recorded;
+    std::thread producer([&] {
+        for (u64 i = 0; i < calls_per_side; i++)
+        {
+            const u64 invoked  = clock.tick();
+            const bool ok      = queue.try_put(first_value + i);
+            const u64 returned = clock.tick();
+            recorded.producer_.push_back(operation{op_kind::put, first_value + i, ok, invoked, returned});
+        }
+    });
+    for (u64 i = 0; i < calls_per_side; i++)
+    {
+        const u64 invoked              = clock.tick();
+        const std::optional<u64> value = queue.try_read();
+        const u64 returned             = clock.tick();
+        recorded.consumer_.push_back(operation{op_kind::read, value.value_or(0), value.has_value(), invoked, returned});
+        if (i % 3 == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    return recorded;
+}
+
+template <typename Queue>
+class spsc_linearizability : public ::testing::Test
+{
+};
+
+using queue_types =
+    ::testing::Types<jc::lockfree::simple_spsc<u64, capacity>, jc::lockfree::cached_spsc<u64, capacity>>;
+
+TYPED_TEST_SUITE(spsc_linearizability, queue_types);
+
+TYPED_TEST(spsc_linearizability, concurrent_histories_linearize)
+{
+    TypeParam queue;
+    history_clock clock;
+    u64 next_value = 1;
+    for (std::size_t round = 0; round < rounds; round++)
+    {
+        const history recorded = record_round(queue, clock, next_value);
+        next_value += calls_per_side;
+
+        // drained sequentially so every round starts from an empty queue
+        history drained = recorded;
+        while (const std::optional<u64> value = queue.try_read())
+        {
+            const u64 at = clock.tick();
+            drained.consumer_.push_back(operation{op_kind::read, *value, true, at, clock.tick()});
+        }
+        ASSERT_TRUE(jc::test::linearizable(drained, capacity)) << "round " << round;
+    }
+}
+
+/*
+ * the checker itself, on histories small enough to work out by hand.
+ */
+TEST(linearizability_checker, accepts_overlapping_put_and_read)
+{
+    // the read overlaps the put, so it may take the value
+    const history recorded{
+        {operation{op_kind::put, 7, true, 0, 3}},
+        {operation{op_kind::read, 7, true, 1, 2}},
+    };
+    EXPECT_TRUE(jc::test::linearizable(recorded, 1));
+}
+
+TEST(linearizability_checker, rejects_read_before_put)
+{
+    // the read returned before the put was invoked
+    const history recorded{
+        {operation{op_kind::put, 7, true, 2, 3}},
+        {operation{op_kind::read, 7, true, 0, 1}},
+    };
+    EXPECT_FALSE(jc::test::linearizable(recorded, 1));
+}
+
+TEST(linearizability_checker, rejects_reordered_values)
+{
+    const history recorded{
+        {operation{op_kind::put, 1, true, 0, 1}, operation{op_kind::put, 2, true, 2, 3}},
+        {operation{op_kind::read, 2, true, 4, 5}, operation{op_kind::read, 1, true, 6, 7}},
+    };
+    EXPECT_FALSE(jc::test::linearizable(recorded, 2));
+}
+
+TEST(linearizability_checker, failed_put_needs_a_full_queue)
+{
+    const history full{
+        {operation{op_kind::put, 1, true, 0, 1}, operation{op_kind::put, 2, false, 2, 3}},
+        {},
+    };
+    EXPECT_TRUE(jc::test::linearizable(full, 1));
+    EXPECT_FALSE(jc::test::linearizable(full, 2));
+}
+
+TEST(linearizability_checker, failed_read_needs_an_empty_queue)
+{
+    // the read overlaps the put, so it can take effect before it
+    const history overlapping{
+        {operation{op_kind::put, 1, true, 0, 3}},
+        {operation{op_kind::read, 0, false, 1, 2}},
+    };
+    EXPECT_TRUE(jc::test::linearizable(overlapping, 1));
+
+    const history after{
+        {operation{op_kind::put, 1, true, 0, 1}},
+        {operation{op_kind::read, 0, false, 2, 3}},
+    };
+    EXPECT_FALSE(jc::test::linearizable(after, 1));
+}
+
+} // namespace
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <jc_collections/lockfree/spsc.hpp>
+#include "../include/model_checker.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+ * The real queues, run on model::atomic indexes over model::var slots, under every interleaving of a short
+ * producer/consumer exchange. Beyond checking order in each interleaving, a slot read that isn't ordered after the
+ * write that filled it, or a slot write not ordered after the read that emptied it, fails as a data race, so the
+ * release/acquire pairs on the indexes are checked too, not just the values.
+ */
+namespace
+{
+
+namespace policy = jc::lockfree::spsc_policy;
+namespace model  = jc::test::model;
+
+using slot = model::var<u64>;
+
+/*
+ * model::atomic with every store downgraded to relaxed, the bug the checker has to catch.
+ */
+template <typename T>
+class relaxed_atomic : public model::atomic<T>
+{
+public:
+    using model::atomic<T>::atomic;
+
+    void store(const T value, std::memory_order = std::memory_order::seq_cst) noexcept
+    {
+        model::atomic<T>::store(value, std::memory_order::relaxed);
+    }
+};
+
+template <std::size_t size, typename indexes, typename release = policy::release_each,
+          typename publishing = policy::publish_each>
+using model_spsc = jc::lockfree::basic_spsc<slot, size, indexes, policy::padding::none, policy::spin_wait,
+                                            policy::move_transfer, policy::bounded, policy::no_prefetch, release,
+                                            publishing>;
+
+/*
+ * the producer try_puts 1..count and the consumer makes count try_reads. What the consumer read has to be a prefix of
+ * what the producer got in, and draining the queue afterwards has to return the rest.
+ */
+template <typename Queue>
+model::result explore_exchange(const u64 count, const model::options opts = {})
+{
+    std::unique_ptr<Queue> queue;
+    std::vector<u64> accepted;
+    std::vector<u64> read;
+
+    model::scheduler scheduler(opts);
+    return scheduler.explore(
+        [&] {
+            queue = std::make_unique<Queue>();
+            accepted.clear();
+            read.clear();
+        },
+        {[&] {
+             for (u64 i = 1; i <= count; i++)
+             {
+                 if (queue->try_put(slot(i)))
+                 {
+                     accepted.push_back(i);
+                 }
+             }
+             queue->flush_writes();
+         },
+         [&] {
+             for (u64 i = 0; i < count; i++)
+             {
+                 if (std::optional<slot> value = queue->try_read())
+                 {
+                     read.push_back(value->get());
+                 }
+             }
+             queue->flush_reads();
+         }},
+        [&] {
+            while (std::optional<slot> value = queue->try_read())
+            {
+                read.push_back(value->get());
+            }
+            model::expect(read == accepted, "reads are not the accepted puts in order");
+        });
+}
+
+template <typename Queue>
+class spsc_model : public ::testing::Test
+{
+};
+
+using queue_types =
+    ::testing::Types<model_spsc<2, policy::basic_shared_indexes<model::atomic>>,
+                     model_spsc<2, policy::basic_cached_indexes<model::atomic>>,
+                     model_spsc<4, policy::basic_cached_indexes<model::atomic>, policy::release_every<2>,
+                                policy::publish_every<2>>>;
+
+TYPED_TEST_SUITE(spsc_model, queue_types);
+
+TYPED_TEST(spsc_model, every_interleaving_keeps_order_without_races)
+{
+    const model::result outcome = explore_exchange<TypeParam>(3);
+    EXPECT_TRUE(outcome.ok()) << outcome.failure << " after " << outcome.executions << " executions";
+    EXPECT_TRUE(outcome.exhausted);
+}
+
+TYPED_TEST(spsc_model, longer_exchange_with_three_preemptions)
+{
+    const model::result outcome = explore_exchange<TypeParam>(6, model::options{.max_preemptions = 3});
+    EXPECT_TRUE(outcome.ok()) << outcome.failure << " after " << outcome.executions << " executions";
+    EXPECT_TRUE(outcome.exhausted);
+}
+
+TEST(spsc_model_checker, relaxed_index_store_is_a_data_race)
+{
+    const model::result outcome = explore_exchange<model_spsc<2, policy::basic_cached_indexes<relaxed_atomic>>>(3);
+    EXPECT_FALSE(outcome.ok());
+    EXPECT_NE(outcome.failure.find("data race"), std::string::npos) << outcome.failure;
+}
+
+} // namespace
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <jc_collections/lockfree/spsc.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+/*
+ * Producer and consumer threads hammering one queue, checking every element arrives once and in order. Built a second
+ * time with ThreadSanitizer (my_tests_tsan), which is what actually checks the memory orderings: a relaxed index
+ * store where a release is needed shows up there as a race on the slot.
+ *
+ * Small rings keep both sides wrapping and running into full/empty all the time. Retry loops yield so the tests still
+ * make progress when both threads share a core.
+ */
+namespace
+{
+
+namespace policy = jc::lockfree::spsc_policy;
+
+constexpr u64 element_count = 100'000;
+
+struct message
+{
+    u64 sequence_;
+    u64 check_;
+};
+
+message make_message(const u64 sequence) noexcept
+{
+    return message{sequence, ~sequence};
+}
+
+template <typename Queue>
+class spsc_stress : public ::testing::Test
+{
+};
+
+/*
+ * simple_spsc and cached_spsc but yielding in the blocking calls, spinning there would stall for a whole timeslice
+ * whenever both threads are on one core. The wait policy doesn't touch the indexes, so the orderings under test are
+ * the same.
+ */
+template <std::size_t size, typename indexes>
+using yielding_spsc = jc::lockfree::basic_spsc<message, size, indexes, policy::padding::cache_line, policy::yield_wait>;
+
+using queue_types = ::testing::Types<
+    yielding_spsc<4, policy::shared_indexes>, yielding_spsc<4, policy::cached_indexes>,
+    yielding_spsc<1024, policy::shared_indexes>, yielding_spsc<1024, policy::cached_indexes>,
+    jc::lockfree::basic_spsc<message, 16, policy::cached_indexes, policy::padding::cache_line, policy::yield_wait,
+                             policy::move_transfer, policy::bounded, policy::no_prefetch, policy::release_every<4>,
+                             policy::publish_every<4>>,
+    jc::lockfree::basic_spsc<message, 16, policy::shared_indexes, policy::padding::none, policy::yield_wait,
+                             policy::memcpy_transfer, policy::bounded, policy::prefetch_ahead<1>,
+                             policy::release_per_line>>;
+
+TYPED_TEST_SUITE(spsc_stress, queue_types);
+
+/*
+ * keeps reading through mismatches so the producer never blocks on a full ring, the test checks the count after join.
+ */
+struct order_check
+{
+    u64 expected_    = 0;
+    u64 mismatches_  = 0;
+    u64 first_wrong_ = 0;
+
+    void operator()(const message &received) noexcept
+    {
+        if (received.sequence_ != expected_ || received.check_ != ~expected_)
+        {
+            first_wrong_ = mismatches_ == 0 ? expected_ : first_wrong_;
+            ++mismatches_;
+        }
+        ++expected_;
+    }
+};
+
+TYPED_TEST(spsc_stress, try_put_try_read_keep_order)
+{
+    auto queue = std::make_unique<TypeParam>();
+    std::thread producer([&] {
+        for (u64 i = 0; i < element_count; i++)
+        {
+            message next = make_message(i);
+            while (!queue->try_put(std::move(next)))
+            {
+                next = make_message(i);
+                std::this_thread::yield();
+            }
+        }
+        queue->flush_writes();
+    });
+
+    order_check check;
+    for (u64 i = 0; i < element_count; i++)
+    {
+        std::optional<message> received;
+        while (!(received = queue->try_read()))
+        {
+            std::this_thread::yield();
+        }
+        check(*received);
+    }
+    producer.join();
+    EXPECT_EQ(check.mismatches_, 0) << "first out of order at " << check.first_wrong_;
+    EXPECT_FALSE(queue->try_read().has_value());
+}
+
+TYPED_TEST(spsc_stress, bulk_put_blocking_read_keep_order)
+{
+    auto queue = std::make_unique<TypeParam>();
+    std::thread producer([&] {
+        std::vector<message> batch;
+        for (u64 i = 0; i < element_count;)
+        {
+            batch.clear();
+            for (u64 j = 0; j < 1 + i % 7 && i + j < element_count; j++)
+            {
+                batch.push_back(make_message(i + j));
+            }
+            std::span<const message> rest = batch;
+            while (!rest.empty())
+            {
+                rest = rest.subspan(queue->try_put_bulk(rest));
+                std::this_thread::yield();
+            }
+            i += batch.size();
+        }
+        queue->flush_writes();
+    });
+
+    order_check check;
+    for (u64 i = 0; i < element_count; i++)
+    {
+        check(queue->read());
+    }
+    producer.join();
+    EXPECT_EQ(check.mismatches_, 0) << "first out of order at " << check.first_wrong_;
+}
+
+TYPED_TEST(spsc_stress, emplace_and_put_keep_order)
+{
+    auto queue = std::make_unique<TypeParam>();
+    std::thread producer([&] {
+        for (u64 i = 0; i < element_count; i++)
+        {
+            if (i % 2 == 0)
+            {
+                queue->emplace(i, ~i);
+            }
+            else
+            {
+                message next = make_message(i);
+                queue->put(next);
+            }
+        }
+        queue->flush_writes();
+    });
+
+    order_check check;
+    for (u64 i = 0; i < element_count; i++)
+    {
+        check(queue->read());
+    }
+    producer.join();
+    EXPECT_EQ(check.mismatches_, 0) << "first out of order at " << check.first_wrong_;
+}
+
+} // namespace